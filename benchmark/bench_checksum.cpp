@@ -0,0 +1,104 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive.h>
+
+#include <numeric>
+#include <sstream>
+
+using namespace zen;
+
+namespace
+{
+struct Record {
+    std::string name;
+    std::int64_t id{0};
+    std::vector<float> samples;
+
+    SERIALIZE_MEMBER(name, id, samples)
+};
+
+std::vector<Record> MakeRecords(std::size_t count, std::size_t samples)
+{
+    std::vector<Record> records(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        records[i].name = fmt::format("record{}", i);
+        records[i].id = static_cast<std::int64_t>(i);
+        records[i].samples.resize(samples);
+        std::iota(records[i].samples.begin(), records[i].samples.end(),
+                  static_cast<float>(i));
+    }
+    return records;
+}
+
+void Run(std::string_view scene, const std::vector<Record> &records)
+{
+    std::vector<std::byte> plain;
+    {
+        OutArchive oar{BufferBinarySerializer{plain}};
+        oar(make_nvp("records", records));
+        oar.Flush();
+    }
+    auto bytes = plain.size();
+    auto plain_load = bench::Measure([&] {
+        std::vector<Record> out;
+        InArchive iar{BufferBinaryDeserializer{plain}};
+        iar(make_nvp("records", out));
+    });
+    bench::Report(fmt::format("{} plain load", scene), bytes, plain_load);
+
+    std::vector<std::byte> checked;
+    auto save = bench::Measure([&] {
+        checked.clear();
+        OutArchive oar{BufferChecksummedBinarySerializer{
+            ChecksumSink<BufferSink>{checked}}};
+        oar(make_nvp("records", records));
+        oar.Flush();
+    });
+    bench::Report(fmt::format("{} checksummed save", scene), bytes, save);
+
+    std::string stream_bytes(reinterpret_cast<const char *>(checked.data()),
+                             checked.size());
+    for (auto [name, verify] : {std::pair{"eager", ChecksumVerify::Eager},
+                                std::pair{"lazy", ChecksumVerify::Lazy},
+                                std::pair{"off", ChecksumVerify::Off}}) {
+        auto load = bench::Measure([&] {
+            std::vector<Record> out;
+            InArchive iar{BufferChecksummedBinaryDeserializer{
+                ChecksumSource<SpanSource>{checked, {.verify = verify}}}};
+            iar(make_nvp("records", out));
+        });
+        bench::Report(fmt::format("{} buffer load, {}", scene, name), bytes,
+                      load);
+
+        auto stream_load = bench::Measure([&] {
+            std::istringstream is(stream_bytes);
+            std::vector<Record> out;
+            InArchive iar{ChecksummedBinaryDeserializer{
+                ChecksumSource<StreamSource>{is, {.verify = verify}}}};
+            iar(make_nvp("records", out));
+        });
+        bench::Report(fmt::format("{} stream load, {}", scene, name), bytes,
+                      stream_load);
+    }
+
+    auto crc = bench::Measure([&] {
+        volatile auto c = detail::Crc32c(plain.data(), plain.size());
+        (void)c;
+    });
+    bench::Report(fmt::format("{} crc32c", scene), bytes, crc);
+    auto scalar = bench::Measure([&] {
+        volatile auto c = detail::Crc32cScalar(plain.data(), plain.size());
+        (void)c;
+    });
+    bench::Report(fmt::format("{} crc32c scalar", scene), bytes, scalar);
+}
+} // namespace
+
+int main()
+{
+    // bulk data dominates
+    Run("bulk", MakeRecords(1'000, 50'000));
+    // many small records, the per value overhead dominates
+    Run("small", MakeRecords(1'000'000, 4));
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive.h>
+
+#include <random>
+
+using namespace zen;
+
+namespace
+{
+struct Record {
+    std::uint32_t id{0};
+    std::int32_t delta{0};
+    std::uint16_t kind{0};
+    double value{0};
+    std::vector<std::int32_t> samples;
+
+    SERIALIZE_MEMBER(id, delta, kind, value, samples)
+};
+
+std::vector<Record> MakeRecords(std::size_t n)
+{
+    std::mt19937 rng(42);
+    std::geometric_distribution<int> small(0.05);
+    std::vector<Record> records(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        auto &r = records[i];
+        r.id = static_cast<std::uint32_t>(i);
+        r.delta = small(rng) - 10;
+        r.kind = static_cast<std::uint16_t>(small(rng));
+        r.value = i * 0.5;
+        r.samples.resize(16);
+        for (auto &s : r.samples) {
+            s = small(rng);
+        }
+    }
+    return records;
+}
+
+void Run(std::string_view name, const std::vector<Record> &records,
+         BinaryOptions options)
+{
+    std::vector<std::byte> buffer;
+    auto save = bench::Measure([&] {
+        OutArchive oar{BufferBinarySerializer{buffer, options}};
+        oar(make_nvp("records", records));
+        oar.Flush();
+    });
+    bench::Report(fmt::format("{} save", name), buffer.size(), save);
+
+    std::vector<Record> out;
+    auto load = bench::Measure([&] {
+        InArchive iar{BufferBinaryDeserializer{buffer, options}};
+        iar(make_nvp("records", out));
+    });
+    bench::Report(fmt::format("{} load", name), buffer.size(), load);
+}
+} // namespace
+
+int main()
+{
+    auto records = MakeRecords(1'000'000);
+    Run("fixed", records, {});
+    Run("compact", records, {.compact = true});
+
+    // bulk integer arrays are where the SIMD decoder kicks in
+    std::vector<std::int64_t> values(20'000'000);
+    std::mt19937 rng(7);
+    std::geometric_distribution<int> small(0.1);
+    for (auto &v : values) {
+        v = small(rng) - 5;
+    }
+    for (auto [name, options] :
+         {std::pair{"fixed int64[]", BinaryOptions{}},
+          std::pair{"compact int64[]", BinaryOptions{.compact = true}}}) {
+        std::vector<std::byte> buffer;
+        auto save = bench::Measure([&] {
+            OutArchive oar{BufferBinarySerializer{buffer, options}};
+            oar(make_nvp("values", values));
+            oar.Flush();
+        });
+        bench::Report(fmt::format("{} save", name), buffer.size(), save);
+
+        std::vector<std::int64_t> out;
+        auto load = bench::Measure([&] {
+            InArchive iar{BufferBinaryDeserializer{buffer, options}};
+            iar(make_nvp("values", out));
+        });
+        bench::Report(fmt::format("{} load", name), buffer.size(), load);
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive.h>
+
+#include <cmath>
+#include <sstream>
+#include <spanstream>
+
+using namespace zen;
+
+namespace
+{
+struct Mesh {
+    std::string name;
+    std::vector<std::array<float, 3>> vertices;
+    std::vector<std::uint32_t> indices;
+
+    SERIALIZE_MEMBER(name, vertices, indices)
+};
+
+struct Node {
+    std::string name;
+    std::array<double, 16> transform{};
+    std::shared_ptr<Mesh> mesh;
+    std::vector<std::shared_ptr<Node>> children;
+
+    SERIALIZE_MEMBER(name, transform, mesh, children)
+};
+
+/// a grid of nodes with smooth meshes, which compresses like real geometry
+std::shared_ptr<Node> MakeScene(std::size_t nodes, std::size_t mesh_size)
+{
+    auto root = std::make_shared<Node>();
+    root->name = "root";
+    for (std::size_t i = 0; i < nodes; ++i) {
+        auto node = std::make_shared<Node>();
+        node->name = fmt::format("node{}", i);
+        node->transform[0] = node->transform[5] = node->transform[10] = 1;
+        node->transform[15] = 1;
+        node->transform[12] = static_cast<double>(i % 100);
+        node->transform[13] = static_cast<double>(i / 100);
+        auto mesh = std::make_shared<Mesh>();
+        mesh->name = fmt::format("mesh{}", i);
+        for (std::size_t v = 0; v < mesh_size; ++v) {
+            auto t = static_cast<float>(v) / mesh_size;
+            mesh->vertices.push_back(
+                {std::cos(t * 6.28f), std::sin(t * 6.28f), t});
+            mesh->indices.insert(mesh->indices.end(),
+                                 {static_cast<std::uint32_t>(v),
+                                  static_cast<std::uint32_t>(v + 1),
+                                  static_cast<std::uint32_t>(v + 2)});
+        }
+        node->mesh = std::move(mesh);
+        root->children.push_back(std::move(node));
+    }
+    return root;
+}
+} // namespace
+
+int main()
+{
+    auto scene = MakeScene(2'000, 5'000);
+
+    std::vector<std::byte> plain;
+    auto save = bench::Measure([&] {
+        plain.clear();
+        OutArchive oar{BufferBinarySerializer{plain}};
+        oar(make_nvp("scene", scene));
+        oar.Flush();
+    });
+    bench::Report("save", plain.size(), save);
+
+    // the current way: serialize, then compress the whole buffer afterwards
+    CompressionOptions defaults;
+    std::size_t packed = 0;
+    auto post = bench::Measure([&] {
+        std::vector<std::byte> buffer;
+        OutArchive oar{BufferBinarySerializer{buffer}};
+        oar(make_nvp("scene", scene));
+        oar.Flush();
+        packed = 0;
+        for (std::size_t offset = 0; offset < buffer.size();
+             offset += defaults.block_size) {
+            auto size = std::min(defaults.block_size, buffer.size() - offset);
+            packed += detail::EncodeFrame(defaults.codec, defaults.level,
+                                          std::span(buffer).subspan(offset,
+                                                                    size))
+                          .size();
+        }
+    });
+    bench::Report("save + compress pass", plain.size(), post);
+
+    for (std::size_t threads : {std::size_t{1}, std::size_t{0}}) {
+        ThreadPool pool(threads);
+        CompressionOptions options{.pool = &pool};
+        std::string compressed;
+        auto streaming = bench::Measure([&] {
+            std::ostringstream os;
+            OutArchive oar{CompressedBinarySerializer{
+                CompressingSink<StreamSink>{os, options}}};
+            oar(make_nvp("scene", scene));
+            oar.Flush();
+            compressed = std::move(os).str();
+        });
+        bench::Report(fmt::format("streaming save, {} threads", pool.Size()),
+                      plain.size(), streaming);
+
+        auto load = bench::Measure([&] {
+            std::shared_ptr<Node> out;
+            std::ispanstream is(compressed);
+            InArchive iar{CompressedBinaryDeserializer{
+                DecompressingSource<StreamSource>{is, options}}};
+            iar(make_nvp("scene", out));
+        });
+        bench::Report(fmt::format("streaming load, {} threads", pool.Size()),
+                      plain.size(), load);
+        SPDLOG_INFO("ratio {:.2f} (compress pass {:.2f})",
+                    double(plain.size()) / compressed.size(),
+                    double(plain.size()) / std::max<std::size_t>(packed, 1));
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive.h>
+#include <zen_serialization/mapped_archive.h>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace zen;
+
+namespace
+{
+struct Header {
+    std::string title;
+    std::int32_t version{0};
+    std::uint64_t frames{0};
+
+    SERIALIZE_MEMBER(title, version, frames)
+};
+
+struct Frame {
+    std::string name;
+    std::vector<float> samples;
+    std::vector<std::string> tags;
+
+    SERIALIZE_MEMBER(name, samples, tags)
+};
+} // namespace
+
+int main()
+{
+    Header header{"capture", 2, 20'000};
+    std::map<std::string, std::string> metadata{{"device", "bench"},
+                                                {"units", "mm"}};
+    std::vector<Frame> frames(header.frames);
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        frames[i].name = fmt::format("frame{}", i);
+        frames[i].samples.assign(4'000, static_cast<float>(i));
+        frames[i].tags = {"a", "b", fmt::format("t{}", i % 7)};
+    }
+
+    auto path = std::filesystem::temp_directory_path() / "zen_bench_index.bin";
+    BinaryOptions options{.indexed = true};
+    {
+        std::vector<std::byte> buffer;
+        OutArchive oar{BufferBinarySerializer{buffer, options}};
+        oar(make_nvp("header", header), make_nvp("frames", frames),
+            make_nvp("metadata", metadata));
+        oar.Flush();
+        std::ofstream os(path, std::ios::binary);
+        os.write(reinterpret_cast<const char *>(buffer.data()),
+                 static_cast<std::streamsize>(buffer.size()));
+    }
+    auto bytes = std::filesystem::file_size(path);
+
+    auto full = bench::Measure(
+        [&] {
+            MappedInArchive mapped(path);
+            InArchive iar{BufferBinaryDeserializer{mapped.Bytes(), options}};
+            Header h;
+            std::vector<Frame> f;
+            std::map<std::string, std::string> m;
+            iar(make_nvp("header", h), make_nvp("frames", f),
+                make_nvp("metadata", m));
+        },
+        3);
+    bench::Report("full load for header + metadata", bytes, full);
+
+    auto seek = bench::Measure([&] {
+        MappedInArchive mapped(path);
+        InArchive iar{BufferBinaryDeserializer{mapped.Bytes(), options}};
+        Header h;
+        std::map<std::string, std::string> m;
+        iar.Seek("header")(make_nvp("header", h));
+        iar.Seek("metadata")(make_nvp("metadata", m));
+    });
+    bench::Report("seek header + metadata", bytes, seek);
+
+    auto slice = bench::Measure([&] {
+        MappedInArchive mapped(path);
+        InArchive iar{BufferBinaryDeserializer{mapped.Bytes(), options}};
+        std::vector<Frame> f;
+        iar.LoadRange("frames", 15'000, 100, f);
+    });
+    bench::Report("load 100 frames of 20000", bytes, slice);
+
+    auto stream = bench::Measure([&] {
+        std::ifstream is(path, std::ios::binary);
+        InArchive iar{BinaryDeserializer{is, options}};
+        Header h;
+        iar.Seek("header")(make_nvp("header", h));
+    });
+    bench::Report("seek header from ifstream", bytes, stream);
+
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive.h>
+
+using namespace zen;
+
+namespace
+{
+struct Thumbnail {
+    std::int32_t width{0};
+    std::int32_t height{0};
+    std::vector<std::uint8_t> pixels;
+
+    SERIALIZE_MEMBER(width, height, pixels)
+};
+
+struct Edit {
+    std::string action;
+    std::string target;
+    std::int64_t time{0};
+
+    SERIALIZE_MEMBER(action, target, time)
+};
+
+template <template <typename> typename Member>
+struct Node {
+    std::string name;
+    std::vector<float> transform;
+    Member<Thumbnail> thumbnail;
+    Member<std::vector<Edit>> history;
+
+    SERIALIZE_MEMBER(name, transform, thumbnail, history)
+};
+
+template <typename T>
+using Eager = T;
+
+template <template <typename> typename Member>
+std::vector<Node<Member>> MakeScene(std::size_t n)
+{
+    std::vector<Node<Member>> nodes(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        auto &node = nodes[i];
+        node.name = fmt::format("node{}", i);
+        node.transform.assign(16, static_cast<float>(i));
+        Thumbnail thumbnail{32, 32, std::vector<std::uint8_t>(32 * 32 * 4)};
+        node.thumbnail = std::move(thumbnail);
+        std::vector<Edit> history;
+        for (int j = 0; j < 40; ++j) {
+            history.push_back({"move", fmt::format("node{}", i), j});
+        }
+        node.history = std::move(history);
+    }
+    return nodes;
+}
+
+template <typename Scene>
+std::vector<std::byte> Save(const Scene &scene)
+{
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{buffer}};
+    oar(make_nvp("nodes", scene));
+    oar.Flush();
+    return buffer;
+}
+} // namespace
+
+int main()
+{
+    constexpr std::size_t n = 20'000;
+    auto eager = Save(MakeScene<Eager>(n));
+    auto lazy = Save(MakeScene<Lazy>(n));
+
+    auto full = bench::Measure([&] {
+        InArchive iar{BufferBinaryDeserializer{eager}};
+        std::vector<Node<Eager>> nodes;
+        iar(make_nvp("nodes", nodes));
+    });
+    bench::Report("eager load", eager.size(), full);
+
+    auto deferred = bench::Measure([&] {
+        InArchive iar{BufferBinaryDeserializer{lazy}};
+        std::vector<Node<Lazy>> nodes;
+        iar(make_nvp("nodes", nodes));
+    });
+    bench::Report("lazy load", lazy.size(), deferred);
+
+    auto touched = bench::Measure([&] {
+        InArchive iar{BufferBinaryDeserializer{lazy}};
+        std::vector<Node<Lazy>> nodes;
+        iar(make_nvp("nodes", nodes));
+        for (std::size_t i = 0; i < nodes.size(); i += 100) {
+            nodes[i].thumbnail.get();
+            nodes[i].history.get();
+        }
+    });
+    bench::Report("lazy load, touch 1%", lazy.size(), touched);
+
+    auto all = bench::Measure([&] {
+        InArchive iar{BufferBinaryDeserializer{lazy}};
+        std::vector<Node<Lazy>> nodes;
+        iar(make_nvp("nodes", nodes));
+        for (auto &node : nodes) {
+            node.thumbnail.get();
+            node.history.get();
+        }
+    });
+    bench::Report("lazy load, touch all", lazy.size(), all);
+
+    auto save = bench::Measure([&] { Save(MakeScene<Lazy>(n / 10)); });
+    auto save_eager = bench::Measure([&] { Save(MakeScene<Eager>(n / 10)); });
+    bench::Report("build + save 10%, eager", eager.size() / 10, save_eager);
+    bench::Report("build + save 10%, lazy", lazy.size() / 10, save);
+    return 0;
+}
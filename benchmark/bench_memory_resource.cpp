@@ -0,0 +1,96 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive.h>
+
+#include <memory_resource>
+
+using namespace zen;
+
+namespace
+{
+struct Node {
+    std::int32_t value{0};
+    std::shared_ptr<Node> parent;
+    std::shared_ptr<Node> link;
+
+    SERIALIZE_MEMBER(value, parent, link)
+};
+
+/// same graph as bench_pointers
+std::vector<std::shared_ptr<Node>> MakeGraph(std::size_t n)
+{
+    std::vector<std::shared_ptr<Node>> nodes(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        nodes[i] = std::make_shared<Node>();
+        nodes[i]->value = static_cast<std::int32_t>(i);
+        if (i > 0) {
+            nodes[i]->parent = nodes[(i - 1) / 2];
+            nodes[i]->link = nodes[(i * 7919) % i];
+        }
+    }
+    return nodes;
+}
+
+/// sum over the graph in read order, touching both neighbours of every node
+std::int64_t Walk(const std::vector<std::shared_ptr<Node>> &nodes)
+{
+    std::int64_t sum = 0;
+    for (const auto &node : nodes) {
+        sum += node->value;
+        if (node->parent) {
+            sum += node->parent->value + node->link->value;
+        }
+    }
+    return sum;
+}
+} // namespace
+
+int main()
+{
+    constexpr std::size_t n = 1'000'000;
+    std::vector<std::byte> buffer;
+    {
+        OutArchive oar{BufferBinarySerializer{buffer}};
+        oar(make_nvp("nodes", MakeGraph(n)));
+        oar.Flush();
+    }
+    std::vector<std::shared_ptr<Node>> loaded;
+    std::int64_t sum = 0;
+
+    // load and release; the heap frees node by node, the arena at once
+    auto heap = bench::Measure([&] {
+        InArchive iar{BufferBinaryDeserializer{buffer}};
+        iar(make_nvp("nodes", loaded));
+        loaded.clear();
+    });
+    std::pmr::monotonic_buffer_resource arena;
+    auto pooled = bench::Measure([&] {
+        {
+            InArchive iar{BufferBinaryDeserializer{buffer}};
+            iar.SetMemoryResource(&arena);
+            iar(make_nvp("nodes", loaded));
+            loaded.clear();
+        }
+        arena.release();
+    });
+    bench::Report("heap load+free", buffer.size(), heap);
+    bench::Report("arena load+free", buffer.size(), pooled);
+
+    {
+        InArchive iar{BufferBinaryDeserializer{buffer}};
+        iar(make_nvp("nodes", loaded));
+    }
+    auto heap_walk = bench::Measure([&] { sum += Walk(loaded); });
+    loaded.clear();
+    {
+        InArchive iar{BufferBinaryDeserializer{buffer}};
+        iar.SetMemoryResource(&arena);
+        iar(make_nvp("nodes", loaded));
+    }
+    auto arena_walk = bench::Measure([&] { sum += Walk(loaded); });
+    loaded.clear();
+    bench::Report("heap walk", buffer.size(), heap_walk);
+    bench::Report("arena walk", buffer.size(), arena_walk);
+    SPDLOG_INFO("checksum {}", sum);
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive.h>
+
+using namespace zen;
+
+namespace
+{
+struct Node {
+    std::int32_t value{0};
+    std::shared_ptr<Node> parent;
+    std::shared_ptr<Node> link;
+
+    SERIALIZE_MEMBER(value, parent, link)
+};
+
+/// n nodes of a binary tree, each also linked to an arbitrary node before
+/// it; both refer to nodes written already, so every node is one definition
+/// and two lookups
+std::vector<std::shared_ptr<Node>> MakeGraph(std::size_t n)
+{
+    std::vector<std::shared_ptr<Node>> nodes(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        nodes[i] = std::make_shared<Node>();
+        nodes[i]->value = static_cast<std::int32_t>(i);
+        if (i > 0) {
+            nodes[i]->parent = nodes[(i - 1) / 2];
+            nodes[i]->link = nodes[(i * 7919) % i];
+        }
+    }
+    return nodes;
+}
+
+std::vector<std::byte> Save(const std::vector<std::shared_ptr<Node>> &nodes,
+                            BinaryOptions options)
+{
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{buffer, options}};
+    oar(make_nvp("nodes", nodes));
+    oar.Flush();
+    return buffer;
+}
+} // namespace
+
+int main()
+{
+    constexpr std::size_t n = 1'000'000;
+    auto nodes = MakeGraph(n);
+    for (auto [name, options] :
+         {std::pair{"plain", BinaryOptions{}},
+          std::pair{"compact", BinaryOptions{.compact = true}}}) {
+        auto buffer = Save(nodes, options);
+        auto save = bench::Measure([&] { Save(nodes, options); });
+        auto load = bench::Measure([&] {
+            InArchive iar{BufferBinaryDeserializer{buffer, options}};
+            std::vector<std::shared_ptr<Node>> loaded;
+            iar(make_nvp("nodes", loaded));
+        });
+        bench::Report(fmt::format("{} save", name), buffer.size(), save);
+        bench::Report(fmt::format("{} load", name), buffer.size(), load);
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive.h>
+
+#include <cstring>
+#include <numeric>
+
+using namespace zen;
+
+namespace
+{
+template <typename T>
+void Run(std::string_view type, std::size_t n)
+{
+    std::vector<T> values(n);
+    std::iota(values.begin(), values.end(), T{0});
+    auto bytes = n * sizeof(T);
+
+    std::vector<T> copy(n);
+    auto raw = bench::Measure(
+        [&] { std::memcpy(copy.data(), values.data(), bytes); });
+    bench::Report(fmt::format("{} memcpy", type), bytes, raw);
+
+    for (auto [name, options] :
+         {std::pair{"native", BinaryOptions{}},
+          std::pair{"portable", BinaryOptions{.portable = true}}}) {
+        std::vector<std::byte> buffer;
+        auto save = bench::Measure([&] {
+            OutArchive oar{BufferBinarySerializer{buffer, options}};
+            oar(make_nvp("values", values));
+            oar.Flush();
+        });
+        bench::Report(fmt::format("{} {} save", type, name), bytes, save);
+
+        std::vector<T> out;
+        auto load = bench::Measure([&] {
+            InArchive iar{BufferBinaryDeserializer{buffer, options}};
+            iar(make_nvp("values", out));
+        });
+        bench::Report(fmt::format("{} {} load", type, name), bytes, load);
+
+        if (options.portable) {
+            // turn it into the archive a host of the other byte order writes:
+            // header, then the range size, then the elements
+            buffer[5] ^= std::byte{BinaryOptions::BigEndianFlag};
+            detail::ByteSwapInPlace(buffer.data() + 6, 1, 8);
+            detail::ByteSwapInPlace(buffer.data() + 14, n, sizeof(T));
+            auto swapped = bench::Measure([&] {
+                InArchive iar{BufferBinaryDeserializer{buffer, options}};
+                iar(make_nvp("values", out));
+            });
+            bench::Report(fmt::format("{} {} swapped load", type, name), bytes,
+                          swapped);
+            if (out != values) {
+                SPDLOG_ERROR("swapped load mismatch");
+            }
+        }
+    }
+
+    auto scalar = bench::Measure([&] {
+        detail::ByteSwapInPlaceScalar(copy.data(), copy.size(), sizeof(T));
+    });
+    bench::Report(fmt::format("{} scalar byteswap", type), bytes, scalar);
+    auto simd = bench::Measure([&] {
+        detail::ByteSwapInPlace(copy.data(), copy.size(), sizeof(T));
+    });
+    bench::Report(fmt::format("{} simd byteswap", type), bytes, simd);
+}
+} // namespace
+
+int main()
+{
+    Run<std::uint16_t>("uint16[]", 64'000'000);
+    Run<float>("float[]", 32'000'000);
+    Run<double>("double[]", 16'000'000);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive_pool.h>
+
+using namespace zen;
+
+namespace
+{
+struct Order {
+    std::int64_t id{0};
+    std::string symbol;
+    double price{0};
+    std::int32_t quantity{0};
+    std::vector<std::string> tags;
+
+    SERIALIZE_MEMBER(id, symbol, price, quantity, tags)
+};
+
+Order MakeOrder(std::int64_t id)
+{
+    return Order{id, "ZEN", 100.25 + id % 17, static_cast<std::int32_t>(id),
+                 {"limit", "day"}};
+}
+} // namespace
+
+int main()
+{
+    // many small messages, where setting an archive up costs as much as
+    // writing the message
+    constexpr std::int64_t n = 1'000'000;
+    for (auto [name, options] :
+         {std::pair{"plain", BinaryOptions{}},
+          std::pair{"compact", BinaryOptions{.compact = true}},
+          std::pair{"string table",
+                    BinaryOptions{.string_table = true, .type_ids = true}}}) {
+        std::vector<std::byte> buffer;
+        std::size_t bytes = 0;
+        auto fresh = bench::Measure([&] {
+            bytes = 0;
+            for (std::int64_t i = 0; i < n; ++i) {
+                OutArchive oar{BufferBinarySerializer{buffer, options}};
+                oar(make_nvp("order", MakeOrder(i)));
+                oar.Flush();
+                bytes += buffer.size();
+            }
+        });
+        auto pooled = bench::Measure([&] {
+            for (std::int64_t i = 0; i < n; ++i) {
+                ArchivePool::Save(buffer, options,
+                                  make_nvp("order", MakeOrder(i)));
+            }
+        });
+        auto fresh_load = bench::Measure([&] {
+            for (std::int64_t i = 0; i < n; ++i) {
+                InArchive iar{BufferBinaryDeserializer{buffer, options}};
+                Order order;
+                iar(make_nvp("order", order));
+            }
+        });
+        auto pooled_load = bench::Measure([&] {
+            for (std::int64_t i = 0; i < n; ++i) {
+                Order order;
+                ArchivePool::Load(buffer, options, make_nvp("order", order));
+            }
+        });
+        bench::Report(fmt::format("{} fresh save", name), bytes, fresh);
+        bench::Report(fmt::format("{} pooled save", name), bytes, pooled);
+        bench::Report(fmt::format("{} fresh load", name), bytes, fresh_load);
+        bench::Report(fmt::format("{} pooled load", name), bytes,
+                      pooled_load);
+    }
+    return 0;
+}
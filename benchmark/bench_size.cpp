@@ -0,0 +1,99 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive.h>
+#include <zen_serialization/size_archive.h>
+
+#include <random>
+
+using namespace zen;
+
+namespace
+{
+struct Mesh {
+    std::string name;
+    std::vector<std::array<float, 3>> vertices;
+    std::vector<std::uint32_t> indices;
+
+    SERIALIZE_MEMBER(name, vertices, indices)
+};
+
+struct Node {
+    std::string name;
+    std::array<double, 16> transform{};
+    std::shared_ptr<Mesh> mesh;
+    std::vector<std::shared_ptr<Node>> children;
+
+    SERIALIZE_MEMBER(name, transform, mesh, children)
+};
+
+std::shared_ptr<Node> MakeScene(std::size_t nodes, std::size_t mesh_count,
+                                std::size_t mesh_size)
+{
+    std::mt19937 rng(3);
+    std::vector<std::shared_ptr<Mesh>> meshes(mesh_count);
+    for (std::size_t i = 0; i < meshes.size(); ++i) {
+        meshes[i] = std::make_shared<Mesh>();
+        meshes[i]->name = fmt::format("mesh{}", i);
+        meshes[i]->vertices.resize(mesh_size + rng() % mesh_size);
+        meshes[i]->indices.resize(3 * (mesh_size + rng() % mesh_size));
+    }
+    auto root = std::make_shared<Node>();
+    std::vector<std::shared_ptr<Node>> all{root};
+    for (std::size_t i = 1; i < nodes; ++i) {
+        auto node = std::make_shared<Node>();
+        node->name = fmt::format("node{}", i);
+        node->mesh = meshes[rng() % meshes.size()];
+        all[rng() % all.size()]->children.push_back(node);
+        all.push_back(node);
+    }
+    return root;
+}
+
+
+void Run(std::string_view scene_name, const std::shared_ptr<Node> &scene)
+{
+    for (auto [name, options] :
+         {std::pair{"fixed", BinaryOptions{}},
+          std::pair{"compact", BinaryOptions{.compact = true}}}) {
+        std::size_t size = 0;
+        auto measure = bench::Measure([&] {
+            SizeArchive sizer{options};
+            sizer(make_nvp("scene", scene));
+            size = sizer.Size();
+        });
+        bench::Report(fmt::format("{} {} size pass", scene_name, name), size,
+                      measure);
+
+        auto grow = bench::Measure([&] {
+            std::vector<std::byte> buffer;
+            OutArchive oar{BufferBinarySerializer{buffer, options}};
+            oar(make_nvp("scene", scene));
+            oar.Flush();
+        });
+        bench::Report(fmt::format("{} {} growing buffer", scene_name, name),
+                      size, grow);
+
+        auto sized = bench::Measure([&] {
+            SizeArchive sizer{options};
+            sizer(make_nvp("scene", scene));
+            std::vector<std::byte> buffer;
+            OutArchive oar{BufferBinarySerializer{
+                BufferSink{buffer, sizer.Size()}, options}};
+            oar(make_nvp("scene", scene));
+            oar.Flush();
+        });
+        bench::Report(
+            fmt::format("{} {} size + sized buffer", scene_name, name), size,
+            sized);
+    }
+}
+} // namespace
+
+int main()
+{
+    // many small nodes sharing a few meshes: dominated by the traversal
+    Run("graph", MakeScene(100'000, 64, 1000));
+    // few nodes with large unique meshes: dominated by the bytes
+    Run("data", MakeScene(1'000, 1'000, 20'000));
+    return 0;
+}
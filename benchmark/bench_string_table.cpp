@@ -0,0 +1,65 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive.h>
+
+using namespace zen;
+
+namespace
+{
+struct Event {
+    std::string kind;
+    std::string source;
+    std::map<std::string, std::string> labels;
+    std::int64_t time{0};
+
+    SERIALIZE_MEMBER(kind, source, labels, time)
+};
+
+std::vector<Event> MakeEvents(std::size_t n)
+{
+    const char *kinds[] = {"request", "response", "retry", "timeout"};
+    std::vector<Event> events(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        auto &event = events[i];
+        event.kind = kinds[i % 4];
+        event.source = fmt::format("service-{}.cluster.internal", i % 32);
+        event.labels = {{"region", i % 2 ? "eu-west-1" : "us-east-1"},
+                        {"status", i % 7 ? "ok" : "error"},
+                        {"version", fmt::format("v{}", i % 3)}};
+        event.time = static_cast<std::int64_t>(i);
+    }
+    return events;
+}
+
+std::vector<std::byte> Save(const std::vector<Event> &events,
+                            BinaryOptions options)
+{
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{buffer, options}};
+    oar(make_nvp("events", events));
+    oar.Flush();
+    return buffer;
+}
+} // namespace
+
+int main()
+{
+    auto events = MakeEvents(200'000);
+    for (auto [name, options] :
+         {std::pair{"plain", BinaryOptions{}},
+          std::pair{"string table", BinaryOptions{.string_table = true}},
+          std::pair{"compact", BinaryOptions{.compact = true}},
+          std::pair{"compact string table",
+                    BinaryOptions{.compact = true, .string_table = true}}}) {
+        auto buffer = Save(events, options);
+        auto save = bench::Measure([&] { Save(events, options); });
+        auto load = bench::Measure([&] {
+            InArchive iar{BufferBinaryDeserializer{buffer, options}};
+            std::vector<Event> loaded;
+            iar(make_nvp("events", loaded));
+        });
+        bench::Report(fmt::format("{} save", name), buffer.size(), save);
+        bench::Report(fmt::format("{} load", name), buffer.size(), load);
+    }
+    return 0;
+}
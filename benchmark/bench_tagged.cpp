@@ -0,0 +1,92 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive.h>
+
+using namespace zen;
+
+namespace
+{
+struct Vertex {
+    float x{0}, y{0}, z{0};
+    std::int32_t id{0};
+
+    SERIALIZE_MEMBER(x, y, z, id)
+};
+
+struct Mesh {
+    std::string name;
+    std::vector<Vertex> vertices;
+    std::vector<std::uint32_t> indices;
+    std::map<std::string, std::string> attributes;
+
+    SERIALIZE_MEMBER(name, vertices, indices, attributes)
+};
+
+// a later version: attributes were dropped, a material was added
+struct MeshV2 {
+    std::string material{"default"};
+    std::vector<std::uint32_t> indices;
+    std::vector<Vertex> vertices;
+    std::string name;
+
+    SERIALIZE_MEMBER(material, indices, vertices, name)
+};
+
+std::vector<Mesh> MakeMeshes(std::size_t n)
+{
+    std::vector<Mesh> meshes(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        auto &mesh = meshes[i];
+        mesh.name = fmt::format("mesh{}", i);
+        for (int j = 0; j < 64; ++j) {
+            auto v = static_cast<float>(j);
+            mesh.vertices.push_back({v, v * 2, v * 3, j});
+            mesh.indices.push_back(static_cast<std::uint32_t>(j));
+        }
+        mesh.attributes = {{"layer", "0"}, {"visible", "true"}};
+    }
+    return meshes;
+}
+
+std::vector<std::byte> Save(const std::vector<Mesh> &meshes,
+                            BinaryOptions options)
+{
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{buffer, options}};
+    oar(make_nvp("meshes", meshes));
+    oar.Flush();
+    return buffer;
+}
+
+template <typename T>
+void Load(const std::vector<std::byte> &buffer, BinaryOptions options)
+{
+    InArchive iar{BufferBinaryDeserializer{buffer, options}};
+    std::vector<T> meshes;
+    iar(make_nvp("meshes", meshes));
+}
+} // namespace
+
+int main()
+{
+    auto meshes = MakeMeshes(20'000);
+    for (auto [name, options] :
+         {std::pair{"positional", BinaryOptions{}},
+          std::pair{"positional compact", BinaryOptions{.compact = true}},
+          std::pair{"tagged", BinaryOptions{.tagged = true}},
+          std::pair{"tagged compact",
+                    BinaryOptions{.compact = true, .tagged = true}}}) {
+        auto buffer = Save(meshes, options);
+        auto save = bench::Measure([&] { Save(meshes, options); });
+        auto load = bench::Measure([&] { Load<Mesh>(buffer, options); });
+        bench::Report(fmt::format("{} save", name), buffer.size(), save);
+        bench::Report(fmt::format("{} load", name), buffer.size(), load);
+        if (options.tagged) {
+            auto evolved =
+                bench::Measure([&] { Load<MeshV2>(buffer, options); });
+            bench::Report(fmt::format("{} load v2", name), buffer.size(),
+                          evolved);
+        }
+    }
+    return 0;
+}
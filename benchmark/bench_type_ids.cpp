@@ -0,0 +1,89 @@
+#include "bench_util.h"
+
+#include <zen_serialization/archive.h>
+
+using namespace zen;
+
+namespace
+{
+struct Shape {
+    virtual ~Shape() = default;
+    std::int32_t layer{0};
+
+    SERIALIZE_MEMBER(layer)
+};
+
+struct RoundedRectangleShape : Shape {
+    float width{0};
+    float height{0};
+    float radius{0};
+
+    SERIALIZE_MEMBER(BaseClass<Shape>(this), width, height, radius)
+};
+
+struct EllipticalArcShape : Shape {
+    float start{0};
+    float sweep{0};
+
+    SERIALIZE_MEMBER(BaseClass<Shape>(this), start, sweep)
+};
+
+struct GroupShape : Shape {
+    std::vector<std::shared_ptr<Shape>> children;
+
+    SERIALIZE_MEMBER(BaseClass<Shape>(this), children)
+};
+
+std::vector<std::shared_ptr<Shape>> MakeShapes(std::size_t n)
+{
+    std::vector<std::shared_ptr<Shape>> shapes;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto group = std::make_shared<GroupShape>();
+        group->layer = static_cast<std::int32_t>(i);
+        auto rectangle = std::make_shared<RoundedRectangleShape>();
+        rectangle->width = static_cast<float>(i);
+        auto arc = std::make_shared<EllipticalArcShape>();
+        arc->sweep = static_cast<float>(i);
+        group->children = {rectangle, arc};
+        shapes.push_back(group);
+    }
+    return shapes;
+}
+
+std::vector<std::byte> Save(const std::vector<std::shared_ptr<Shape>> &shapes,
+                            BinaryOptions options)
+{
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{buffer, options}};
+    oar(make_nvp("shapes", shapes));
+    oar.Flush();
+    return buffer;
+}
+} // namespace
+
+REGISTER_CLASS(Shape)
+REGISTER_CLASS(RoundedRectangleShape)
+REGISTER_CLASS(EllipticalArcShape)
+REGISTER_CLASS(GroupShape)
+
+int main()
+{
+    auto shapes = MakeShapes(200'000);
+    for (auto [name, options] :
+         {std::pair{"type names", BinaryOptions{}},
+          std::pair{"type ids", BinaryOptions{.type_ids = true}},
+          std::pair{"compact type names", BinaryOptions{.compact = true}},
+          std::pair{"compact type ids",
+                    BinaryOptions{.compact = true, .type_ids = true}}}) {
+        auto buffer = Save(shapes, options);
+        auto save = bench::Measure([&] { Save(shapes, options); });
+        auto load = bench::Measure([&] {
+            InArchive iar{BufferBinaryDeserializer{buffer, options}};
+            std::vector<std::shared_ptr<Shape>> loaded;
+            iar(make_nvp("shapes", loaded));
+        });
+        bench::Report(fmt::format("{} save", name), buffer.size(), save);
+        bench::Report(fmt::format("{} load", name), buffer.size(), load);
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file bench_util.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 16:47:20, October 18, 2025
+ */
+#pragma once
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <string_view>
+
+namespace bench
+{
+
+/// best wall time of `repeat` runs in seconds
+template <typename F>
+double Measure(F &&f, int repeat = 5)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeat; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best,
+                        std::chrono::duration<double>(stop - start).count());
+    }
+    return best;
+}
+
+inline void Report(std::string_view name, std::size_t bytes, double seconds)
+{
+    SPDLOG_INFO("{:<32} {:>12} bytes {:>10.3f} ms {:>10.1f} MB/s", name, bytes,
+                seconds * 1e3, bytes / seconds / 1e6);
+}
+
+} // namespace bench
@@ -9,16 +9,35 @@
 #include <zen_serialization/archive.h>
 #include <zen_serialization/archive_base.h>
 #include <zen_serialization/base64.h>
+#include <zen_serialization/binary_index.h>
+#include <zen_serialization/binary_options.h>
 #include <zen_serialization/binary_serializer.h>
+#include <zen_serialization/bitwise.h>
+#include <zen_serialization/borrowed_blob.h>
+#include <zen_serialization/byteswap.h>
+#include <zen_serialization/checksum.h>
+#include <zen_serialization/compression.h>
+#include <zen_serialization/crc32c.h>
 #include <zen_serialization/json_serializer.h>
+#include <zen_serialization/mapped_archive.h>
+#include <zen_serialization/mapped_file.h>
 #include <zen_serialization/range_size.h>
 #include <zen_serialization/serializer.h>
+#include <zen_serialization/size_archive.h>
+#include <zen_serialization/sink.h>
+#include <zen_serialization/source.h>
+#include <zen_serialization/thread_pool.h>
+#include <zen_serialization/varint.h>
 #include <zen_serialization/aggregate.h>
 
 namespace zen
 {
 static std::map<std::type_index, std::string> g_type_names;
 static std::map<std::string, std::function<void *()>> g_constructors;
+static std::map<
+    std::string,
+    std::function<std::shared_ptr<void>(std::pmr::memory_resource *)>>
+    g_shared_constructors;
 
 static std::map<std::string, std::function<void(void *, OutArchive &ar)>>
     g_serializers;
@@ -50,6 +69,21 @@ ArchiveBase::GetConstructor(const std::string &name)
     return g_constructors.at(name);
 }
 
+void ArchiveBase::RegisterSharedConstructor(
+    const std::string &name,
+    std::function<std::shared_ptr<void>(std::pmr::memory_resource *)>
+        constructor)
+{
+    g_shared_constructors[name] = std::move(constructor);
+}
+
+const std::function<std::shared_ptr<void>(std::pmr::memory_resource *)> *
+ArchiveBase::FindSharedConstructor(const std::string &name)
+{
+    auto it = g_shared_constructors.find(name);
+    return it == g_shared_constructors.end() ? nullptr : &it->second;
+}
+
 void ArchiveBase::RegisterSerializer(
     const std::string &name,
     std::function<void(void *, OutArchive &ar)> serializer)
@@ -0,0 +1,151 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file binary_index.cpp
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 16:58:12, October 21, 2025
+ */
+#include <zen_serialization/binary_index.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace zen
+{
+
+namespace
+{
+class Writer
+{
+public:
+    std::vector<std::byte> bytes;
+
+    void U8(std::uint8_t value) { bytes.push_back(std::byte{value}); }
+
+    void U64(std::uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i) {
+            bytes.push_back(static_cast<std::byte>(value >> (8 * i)));
+        }
+    }
+
+    void String(std::string_view str)
+    {
+        U64(str.size());
+        auto data = reinterpret_cast<const std::byte *>(str.data());
+        bytes.insert(bytes.end(), data, data + str.size());
+    }
+};
+
+class Reader
+{
+    std::span<const std::byte> m_bytes;
+    std::size_t m_pos{0};
+
+public:
+    explicit Reader(std::span<const std::byte> bytes) : m_bytes(bytes) {}
+
+    std::span<const std::byte> Take(std::size_t size)
+    {
+        if (size > m_bytes.size() - m_pos) {
+            ZEN_THROW("Corrupted binary archive index");
+        }
+        auto result = m_bytes.subspan(m_pos, size);
+        m_pos += size;
+        return result;
+    }
+
+    std::uint8_t U8() { return std::to_integer<std::uint8_t>(Take(1)[0]); }
+
+    std::uint64_t U64()
+    {
+        auto bytes = Take(8);
+        std::uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value |= std::to_integer<std::uint64_t>(bytes[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    std::string String()
+    {
+        auto bytes = Take(U64());
+        return {reinterpret_cast<const char *>(bytes.data()), bytes.size()};
+    }
+
+    /// element count that cannot exceed the remaining bytes
+    std::size_t Count(std::size_t min_element_size)
+    {
+        auto n = U64();
+        if (n > (m_bytes.size() - m_pos) / min_element_size) {
+            ZEN_THROW("Corrupted binary archive index");
+        }
+        return n;
+    }
+};
+} // namespace
+
+const IndexEntry *BinaryIndex::Find(std::string_view name) const
+{
+    auto it = std::ranges::find(entries, name, &IndexEntry::name);
+    return it == entries.end() ? nullptr : &*it;
+}
+
+std::vector<std::byte> BinaryIndex::Encode(std::uint64_t offset) const
+{
+    Writer writer;
+    writer.U64(entries.size());
+    for (const auto &entry : entries) {
+        writer.String(entry.name);
+        writer.U64(entry.offset);
+        writer.U64(entry.end);
+        writer.U8(entry.dependent ? 1 : 0);
+        writer.U64(entry.stride);
+        writer.U64(entry.chunks.size());
+        for (std::size_t i = 0; i < entry.chunks.size(); ++i) {
+            writer.U64(entry.chunks[i]);
+            writer.U8(entry.chunk_dependent[i]);
+        }
+    }
+    writer.U64(offset);
+    auto magic = reinterpret_cast<const std::byte *>(Magic.data());
+    writer.bytes.insert(writer.bytes.end(), magic, magic + Magic.size());
+    return std::move(writer.bytes);
+}
+
+BinaryIndex BinaryIndex::Decode(std::span<const std::byte> bytes)
+{
+    ZEN_ENSURE_WITH_MSG(bytes.size() >= FooterSize,
+                        "Binary archive index is truncated");
+    Reader reader(bytes.first(bytes.size() - FooterSize));
+    BinaryIndex index;
+    // an entry takes at least 41 bytes, a chunk 9
+    index.entries.resize(reader.Count(41));
+    for (auto &entry : index.entries) {
+        entry.name = reader.String();
+        entry.offset = reader.U64();
+        entry.end = reader.U64();
+        entry.dependent = reader.U8() != 0;
+        entry.stride = reader.U64();
+        auto chunks = reader.Count(9);
+        entry.chunks.resize(chunks);
+        entry.chunk_dependent.resize(chunks);
+        for (std::size_t i = 0; i < chunks; ++i) {
+            entry.chunks[i] = reader.U64();
+            entry.chunk_dependent[i] = reader.U8();
+        }
+    }
+    return index;
+}
+
+std::uint64_t BinaryIndex::DecodeFooter(std::span<const std::byte> footer)
+{
+    ZEN_ENSURE_WITH_MSG(
+        footer.size() == FooterSize &&
+            std::memcmp(footer.data() + 8, Magic.data(), Magic.size()) == 0,
+        "Binary archive has no index, write it with BinaryOptions::indexed");
+    return Reader(footer).U64();
+}
+
+} // namespace zen
@@ -0,0 +1,233 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file byteswap.cpp
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 10:31:02, October 19, 2025
+ */
+#include <zen_serialization/byteswap.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) ||             \
+    defined(_M_IX86)
+#define ZEN_SERIALIZATION_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(ZEN_SERIALIZATION_X86) && (defined(__GNUC__) || defined(__clang__))
+#define ZEN_TARGET(x) __attribute__((target(x)))
+#else
+#define ZEN_TARGET(x)
+#endif
+
+namespace zen::detail
+{
+
+namespace
+{
+template <typename U>
+void ByteSwapScalar(std::byte *dst, const std::byte *src, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        U v;
+        std::memcpy(&v, src + sizeof(U) * i, sizeof(U));
+        v = std::byteswap(v);
+        std::memcpy(dst + sizeof(U) * i, &v, sizeof(U));
+    }
+}
+} // namespace
+
+void ByteSwapCopyScalar(void *dst, const void *src, std::size_t count,
+                        std::size_t width)
+{
+    auto out = static_cast<std::byte *>(dst);
+    auto in = static_cast<const std::byte *>(src);
+    switch (width) {
+    case 1:
+        if (out != in) {
+            std::memcpy(out, in, count);
+        }
+        break;
+    case 2:
+        ByteSwapScalar<std::uint16_t>(out, in, count);
+        break;
+    case 4:
+        ByteSwapScalar<std::uint32_t>(out, in, count);
+        break;
+    case 8:
+        ByteSwapScalar<std::uint64_t>(out, in, count);
+        break;
+    default:
+        for (std::size_t i = 0; i < count; ++i) {
+            std::reverse_copy(in + width * i, in + width * (i + 1),
+                              out + width * i);
+        }
+    }
+}
+
+void ByteSwapInPlaceScalar(void *data, std::size_t count, std::size_t width)
+{
+    if (width > 8) {
+        auto bytes = static_cast<std::byte *>(data);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::reverse(bytes + width * i, bytes + width * (i + 1));
+        }
+        return;
+    }
+    ByteSwapCopyScalar(data, data, count, width);
+}
+
+#ifdef ZEN_SERIALIZATION_X86
+
+namespace
+{
+// pshufb control reversing every element of `width` bytes in a 16 byte lane
+alignas(16) constexpr std::uint8_t ShuffleMask2[16] = {
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14};
+alignas(16) constexpr std::uint8_t ShuffleMask4[16] = {
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12};
+alignas(16) constexpr std::uint8_t ShuffleMask8[16] = {
+    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8};
+
+constexpr std::size_t StreamingThreshold = 4 << 20;
+
+const std::uint8_t *ShuffleMask(std::size_t width)
+{
+    return width == 2 ? ShuffleMask2 : width == 4 ? ShuffleMask4 : ShuffleMask8;
+}
+
+// both kernels return the number of bytes processed, the caller finishes the
+// tail with the scalar loop
+ZEN_TARGET("ssse3")
+std::size_t ByteSwapSSSE3(std::byte *dst, const std::byte *src,
+                          std::size_t size, std::size_t width)
+{
+    auto mask =
+        _mm_load_si128(reinterpret_cast<const __m128i *>(ShuffleMask(width)));
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                         _mm_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+ZEN_TARGET("avx2")
+std::size_t ByteSwapAVX2(std::byte *dst, const std::byte *src,
+                         std::size_t size, std::size_t width)
+{
+    // vpshufb shuffles within 128 bit lanes, so the mask is just repeated
+    auto lane =
+        _mm_load_si128(reinterpret_cast<const __m128i *>(ShuffleMask(width)));
+    auto mask = _mm256_broadcastsi128_si256(lane);
+    std::size_t i = 0;
+    // like memcpy, bypass the cache for copies much larger than it, which
+    // saves reading the destination lines before they are overwritten
+    if (dst != src && size >= StreamingThreshold &&
+        reinterpret_cast<std::uintptr_t>(dst) % width == 0) {
+        // one unaligned block, then continue from the first aligned element;
+        // the overlap is simply written twice
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst),
+                            _mm256_shuffle_epi8(v, mask));
+        i = (32 - reinterpret_cast<std::uintptr_t>(dst) % 32) % 32;
+        for (; i + 32 <= size; i += 32) {
+            auto v =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i),
+                                _mm256_shuffle_epi8(v, mask));
+        }
+        _mm_sfence();
+        return i;
+    }
+    for (; i + 32 <= size; i += 32) {
+        auto v =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                            _mm256_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+struct CpuFeatures {
+    bool ssse3{false};
+    bool avx2{false};
+
+    CpuFeatures()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        ssse3 = __builtin_cpu_supports("ssse3");
+        avx2 = __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        int max_leaf = info[0];
+        __cpuid(info, 1);
+        ssse3 = (info[2] & (1 << 9)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (max_leaf >= 7 && osxsave && avx &&
+            (_xgetbv(0) & 0x6) == 0x6) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+#endif
+    }
+};
+
+const CpuFeatures &GetCpuFeatures()
+{
+    static const CpuFeatures features;
+    return features;
+}
+} // namespace
+
+void ByteSwapCopy(void *dst, const void *src, std::size_t count,
+                  std::size_t width)
+{
+    if (width != 2 && width != 4 && width != 8) {
+        ByteSwapCopyScalar(dst, src, count, width);
+        return;
+    }
+    auto out = static_cast<std::byte *>(dst);
+    auto in = static_cast<const std::byte *>(src);
+    auto size = count * width;
+    std::size_t done = 0;
+    const auto &cpu = GetCpuFeatures();
+    if (cpu.avx2) {
+        done = ByteSwapAVX2(out, in, size, width);
+    }
+    if (cpu.ssse3) {
+        done += ByteSwapSSSE3(out + done, in + done, size - done, width);
+    }
+    ByteSwapCopyScalar(out + done, in + done, (size - done) / width, width);
+}
+
+#else
+
+void ByteSwapCopy(void *dst, const void *src, std::size_t count,
+                  std::size_t width)
+{
+    ByteSwapCopyScalar(dst, src, count, width);
+}
+
+#endif
+
+void ByteSwapInPlace(void *data, std::size_t count, std::size_t width)
+{
+    if (width > 8) {
+        ByteSwapInPlaceScalar(data, count, width);
+        return;
+    }
+    ByteSwapCopy(data, data, count, width);
+}
+
+} // namespace zen::detail
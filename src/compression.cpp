@@ -0,0 +1,103 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file compression.cpp
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 15:10:24, October 20, 2025
+ */
+#include <zen_serialization/compression.h>
+
+#include <cstring>
+
+#ifdef ZEN_SERIALIZATION_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace zen::detail
+{
+
+bool HasCodec(Codec codec)
+{
+    switch (codec) {
+    case Codec::None:
+        return true;
+    case Codec::Zstd:
+#ifdef ZEN_SERIALIZATION_WITH_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+std::vector<std::byte> EncodeFrame(Codec codec, int level,
+                                   std::span<const std::byte> raw)
+{
+    std::vector<std::byte> frame;
+    std::size_t stored = raw.size();
+    switch (codec) {
+    case Codec::None:
+        frame.resize(FrameHeaderSize + raw.size());
+        std::memcpy(frame.data() + FrameHeaderSize, raw.data(), raw.size());
+        break;
+    case Codec::Zstd: {
+#ifdef ZEN_SERIALIZATION_WITH_ZSTD
+        frame.resize(FrameHeaderSize + ZSTD_compressBound(raw.size()));
+        stored = ZSTD_compress(frame.data() + FrameHeaderSize,
+                               frame.size() - FrameHeaderSize, raw.data(),
+                               raw.size(), level);
+        ZEN_ENSURE_WITH_MSG(!ZSTD_isError(stored),
+                            fmt::format("zstd compression failed: {}",
+                                        ZSTD_getErrorName(stored)));
+        frame.resize(FrameHeaderSize + stored);
+        break;
+#else
+        EnsureCodec(codec);
+#endif
+    }
+    default:
+        EnsureCodec(codec);
+    }
+    StoreFrameHeader(frame.data(), static_cast<std::uint32_t>(stored),
+                     static_cast<std::uint32_t>(raw.size()));
+    return frame;
+}
+
+std::vector<std::byte> DecodeFrame(Codec codec,
+                                   std::span<const std::byte> payload,
+                                   std::size_t raw_size)
+{
+    std::vector<std::byte> raw(raw_size);
+    switch (codec) {
+    case Codec::None:
+        ZEN_ENSURE_WITH_MSG(payload.size() == raw_size,
+                            fmt::format("Corrupted frame, {} bytes stored for "
+                                        "{} raw bytes",
+                                        payload.size(), raw_size));
+        std::memcpy(raw.data(), payload.data(), raw_size);
+        break;
+    case Codec::Zstd: {
+#ifdef ZEN_SERIALIZATION_WITH_ZSTD
+        auto size = ZSTD_decompress(raw.data(), raw.size(), payload.data(),
+                                    payload.size());
+        ZEN_ENSURE_WITH_MSG(!ZSTD_isError(size),
+                            fmt::format("zstd decompression failed: {}",
+                                        ZSTD_getErrorName(size)));
+        ZEN_ENSURE_WITH_MSG(size == raw_size,
+                            fmt::format("Corrupted frame, decoded {} bytes "
+                                        "instead of {}",
+                                        size, raw_size));
+        break;
+#else
+        EnsureCodec(codec);
+#endif
+    }
+    default:
+        EnsureCodec(codec);
+    }
+    return raw;
+}
+
+} // namespace zen::detail
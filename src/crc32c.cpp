@@ -0,0 +1,204 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file crc32c.cpp
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 10:25:13, October 21, 2025
+ */
+#include <zen_serialization/crc32c.h>
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ZEN_SERIALIZATION_X64 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(ZEN_SERIALIZATION_X64) && (defined(__GNUC__) || defined(__clang__))
+#define ZEN_TARGET(x) __attribute__((target(x)))
+#else
+#define ZEN_TARGET(x)
+#endif
+
+namespace zen::detail
+{
+
+namespace
+{
+/// reflected Castagnoli polynomial
+constexpr std::uint32_t Polynomial = 0x82F63B78;
+
+using Table = std::array<std::array<std::uint32_t, 256>, 8>;
+
+constexpr Table MakeTable()
+{
+    Table table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        auto crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ Polynomial : crc >> 1;
+        }
+        table[0][i] = crc;
+    }
+    for (std::size_t i = 0; i < 256; ++i) {
+        for (std::size_t k = 1; k < 8; ++k) {
+            auto prev = table[k - 1][i];
+            table[k][i] = (prev >> 8) ^ table[0][prev & 0xff];
+        }
+    }
+    return table;
+}
+
+constexpr Table CrcTable = MakeTable();
+
+/// the raw register update, without the pre and post inversion
+std::uint32_t UpdateScalar(std::uint32_t crc, const std::byte *data,
+                           std::size_t size)
+{
+    for (; size >= 8; size -= 8, data += 8) {
+        std::uint64_t v;
+        std::memcpy(&v, data, 8);
+        if constexpr (std::endian::native == std::endian::big) {
+            v = std::byteswap(v);
+        }
+        v ^= crc;
+        crc = CrcTable[7][v & 0xff] ^ CrcTable[6][(v >> 8) & 0xff] ^
+              CrcTable[5][(v >> 16) & 0xff] ^ CrcTable[4][(v >> 24) & 0xff] ^
+              CrcTable[3][(v >> 32) & 0xff] ^ CrcTable[2][(v >> 40) & 0xff] ^
+              CrcTable[1][(v >> 48) & 0xff] ^ CrcTable[0][v >> 56];
+    }
+    for (; size > 0; --size, ++data) {
+        crc = (crc >> 8) ^
+              CrcTable[0][(crc ^ std::to_integer<std::uint32_t>(*data)) & 0xff];
+    }
+    return crc;
+}
+} // namespace
+
+std::uint32_t Crc32cScalar(const void *data, std::size_t size,
+                           std::uint32_t crc)
+{
+    return ~UpdateScalar(~crc, static_cast<const std::byte *>(data), size);
+}
+
+#ifdef ZEN_SERIALIZATION_X64
+
+namespace
+{
+/// bytes per stream of the interleaved loops
+constexpr std::size_t LongBlock = 8192;
+constexpr std::size_t ShortBlock = 256;
+
+/// x^n mod P in the reflected domain
+constexpr std::uint32_t XPowMod(std::size_t n)
+{
+    std::uint32_t v = 0x80000000;
+    for (std::size_t i = 0; i < n; ++i) {
+        v = (v & 1) ? (v >> 1) ^ Polynomial : v >> 1;
+    }
+    return v;
+}
+
+// multiplying a crc by these and reducing the 64 bit product with one crc32
+// instruction appends `block` zero bytes to it; the 33 accounts for the
+// reduction by x^32 and the one bit shift of a reflected carry-less product
+constexpr std::uint32_t LongShift = XPowMod(LongBlock * 8 - 33);
+constexpr std::uint32_t ShortShift = XPowMod(ShortBlock * 8 - 33);
+
+ZEN_TARGET("sse4.2,pclmul")
+std::uint32_t Shift(std::uint32_t crc, std::uint32_t constant)
+{
+    auto product = _mm_clmulepi64_si128(_mm_cvtsi32_si128(crc),
+                                        _mm_cvtsi32_si128(constant), 0);
+    return static_cast<std::uint32_t>(
+        _mm_crc32_u64(0, _mm_cvtsi128_si64(product)));
+}
+
+inline std::uint64_t Load64(const std::byte *data)
+{
+    std::uint64_t v;
+    std::memcpy(&v, data, 8);
+    return v;
+}
+
+// the crc32 instruction has a latency of 3 cycles but a throughput of 1, so
+// three independent streams keep it busy; they are merged by shifting the
+// first two past the following blocks
+template <std::size_t Block>
+ZEN_TARGET("sse4.2,pclmul")
+std::uint64_t Interleaved(std::uint64_t crc, const std::byte *&data,
+                          std::size_t &size, std::uint32_t shift)
+{
+    while (size >= 3 * Block) {
+        std::uint64_t crc1 = 0, crc2 = 0;
+        for (std::size_t i = 0; i < Block; i += 8) {
+            crc = _mm_crc32_u64(crc, Load64(data + i));
+            crc1 = _mm_crc32_u64(crc1, Load64(data + Block + i));
+            crc2 = _mm_crc32_u64(crc2, Load64(data + 2 * Block + i));
+        }
+        crc = Shift(Shift(static_cast<std::uint32_t>(crc), shift) ^
+                        static_cast<std::uint32_t>(crc1),
+                    shift) ^
+              crc2;
+        data += 3 * Block;
+        size -= 3 * Block;
+    }
+    return crc;
+}
+
+ZEN_TARGET("sse4.2,pclmul")
+std::uint32_t UpdateHardware(std::uint32_t crc32, const std::byte *data,
+                             std::size_t size)
+{
+    std::uint64_t crc = crc32;
+    crc = Interleaved<LongBlock>(crc, data, size, LongShift);
+    crc = Interleaved<ShortBlock>(crc, data, size, ShortShift);
+    for (; size >= 8; size -= 8, data += 8) {
+        crc = _mm_crc32_u64(crc, Load64(data));
+    }
+    auto result = static_cast<std::uint32_t>(crc);
+    for (; size > 0; --size, ++data) {
+        result = _mm_crc32_u8(result, std::to_integer<std::uint8_t>(*data));
+    }
+    return result;
+}
+
+bool HasHardwareCrc()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("pclmul");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0 && (info[2] & (1 << 1)) != 0;
+#else
+    return false;
+#endif
+}
+} // namespace
+
+std::uint32_t Crc32c(const void *data, std::size_t size, std::uint32_t crc)
+{
+    static const bool hardware = HasHardwareCrc();
+    auto bytes = static_cast<const std::byte *>(data);
+    return hardware ? ~UpdateHardware(~crc, bytes, size)
+                    : ~UpdateScalar(~crc, bytes, size);
+}
+
+#else
+
+std::uint32_t Crc32c(const void *data, std::size_t size, std::uint32_t crc)
+{
+    return Crc32cScalar(data, size, crc);
+}
+
+#endif
+
+} // namespace zen::detail
@@ -0,0 +1,247 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file mapped_file.cpp
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 09:52:03, October 18, 2025
+ */
+#include <zen_serialization/archive_base.h>
+#include <zen_serialization/mapped_file.h>
+
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace zen
+{
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other) {
+        Close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_writable = std::exchange(other.m_writable, false);
+#ifdef _WIN32
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#else
+        m_fd = std::exchange(other.m_fd, -1);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() { Close(); }
+
+#ifdef _WIN32
+
+MappedFile MappedFile::OpenRead(const std::filesystem::path &path)
+{
+    MappedFile file;
+    file.m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file.m_file == INVALID_HANDLE_VALUE) {
+        file.m_file = nullptr;
+        ZEN_THROW(fmt::format("Failed to open {}", path.string()));
+    }
+    LARGE_INTEGER size;
+    GetFileSizeEx(file.m_file, &size);
+    file.m_size = static_cast<std::size_t>(size.QuadPart);
+    file.Map();
+    if (file.m_size > 0) {
+        WIN32_MEMORY_RANGE_ENTRY range{file.m_data, file.m_size};
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+    return file;
+}
+
+MappedFile MappedFile::Create(const std::filesystem::path &path,
+                              std::size_t capacity)
+{
+    MappedFile file;
+    file.m_writable = true;
+    file.m_file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0,
+                              nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file.m_file == INVALID_HANDLE_VALUE) {
+        file.m_file = nullptr;
+        ZEN_THROW(fmt::format("Failed to create {}", path.string()));
+    }
+    file.Resize(capacity);
+    return file;
+}
+
+bool MappedFile::IsOpen() const { return m_file != nullptr; }
+
+void MappedFile::Resize(std::size_t size)
+{
+    ZEN_ENSURE(m_writable)
+    Unmap();
+    LARGE_INTEGER li;
+    li.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(m_file, li, nullptr, FILE_BEGIN) ||
+        !SetEndOfFile(m_file)) {
+        ZEN_THROW(fmt::format("Failed to resize file to {} bytes", size));
+    }
+    m_size = size;
+    Map();
+}
+
+void MappedFile::Map()
+{
+    if (m_size == 0) {
+        return;
+    }
+    m_mapping = CreateFileMappingW(m_file, nullptr,
+                                   m_writable ? PAGE_READWRITE : PAGE_READONLY,
+                                   0, 0, nullptr);
+    if (m_mapping == nullptr) {
+        ZEN_THROW("Failed to create file mapping");
+    }
+    m_data = static_cast<std::byte *>(MapViewOfFile(
+        m_mapping, m_writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, m_size));
+    if (m_data == nullptr) {
+        ZEN_THROW("Failed to map view of file");
+    }
+}
+
+void MappedFile::Unmap()
+{
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+    if (m_mapping != nullptr) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+}
+
+void MappedFile::Close()
+{
+    Unmap();
+    if (m_file != nullptr) {
+        CloseHandle(m_file);
+        m_file = nullptr;
+    }
+    m_size = 0;
+}
+
+#else
+
+MappedFile MappedFile::OpenRead(const std::filesystem::path &path)
+{
+    MappedFile file;
+    file.m_fd = ::open(path.c_str(), O_RDONLY);
+    if (file.m_fd < 0) {
+        ZEN_THROW(fmt::format("Failed to open {}: {}", path.string(),
+                              std::strerror(errno)));
+    }
+    struct stat st;
+    if (::fstat(file.m_fd, &st) != 0) {
+        ZEN_THROW(fmt::format("Failed to stat {}: {}", path.string(),
+                              std::strerror(errno)));
+    }
+    file.m_size = static_cast<std::size_t>(st.st_size);
+    file.Map();
+    if (file.m_size > 0) {
+        ::madvise(file.m_data, file.m_size, MADV_SEQUENTIAL);
+        ::madvise(file.m_data, file.m_size, MADV_WILLNEED);
+    }
+    return file;
+}
+
+MappedFile MappedFile::Create(const std::filesystem::path &path,
+                              std::size_t capacity)
+{
+    MappedFile file;
+    file.m_writable = true;
+    file.m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file.m_fd < 0) {
+        ZEN_THROW(fmt::format("Failed to create {}: {}", path.string(),
+                              std::strerror(errno)));
+    }
+    file.Resize(capacity);
+    return file;
+}
+
+bool MappedFile::IsOpen() const { return m_fd >= 0; }
+
+void MappedFile::Resize(std::size_t size)
+{
+    ZEN_ENSURE(m_writable)
+    Unmap();
+    if (::ftruncate(m_fd, static_cast<off_t>(size)) != 0) {
+        ZEN_THROW(fmt::format("Failed to resize file to {} bytes: {}", size,
+                              std::strerror(errno)));
+    }
+#ifdef __linux__
+    if (size > m_size) {
+        // reserve the blocks up front, a failure only costs the preallocation
+        ::posix_fallocate(m_fd, static_cast<off_t>(m_size),
+                          static_cast<off_t>(size - m_size));
+    }
+#endif
+    m_size = size;
+    Map();
+}
+
+void MappedFile::Map()
+{
+    if (m_size == 0) {
+        return;
+    }
+    int prot = m_writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *data = ::mmap(nullptr, m_size, prot, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED) {
+        ZEN_THROW(fmt::format("Failed to map {} bytes: {}", m_size,
+                              std::strerror(errno)));
+    }
+    m_data = static_cast<std::byte *>(data);
+    if (m_writable) {
+        ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+    }
+}
+
+void MappedFile::Unmap()
+{
+    if (m_data != nullptr) {
+        ::munmap(m_data, m_size);
+        m_data = nullptr;
+    }
+}
+
+void MappedFile::Close()
+{
+    Unmap();
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_size = 0;
+}
+
+#endif
+
+} // namespace zen
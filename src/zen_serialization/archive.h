@@ -10,11 +10,17 @@
 #include "archive_base.h"
 #include "base64.h"
 #include "binary_serializer.h"
+#include "bitwise.h"
 #include "json_serializer.h"
+#include "lazy.h"
+#include "pointer_map.h"
 #include "serializer.h"
 
 #include <iterator>
+#include <memory_resource>
 #include <optional>
+#include <typeindex>
+#include <unordered_map>
 
 namespace zen
 {
@@ -57,9 +63,29 @@ struct NewObjectScope {
 
 class OutArchive : public ArchiveBase
 {
-    std::set<std::uintptr_t> m_pointers;
+    /// object -> id, ids are handed out in traversal order and never reused
+    /// so the same graph always gives the same bytes; 0 is the null pointer
+    detail::PointerMap m_pointers;
+    /// pointers first written inside the open Lazy payloads, which the rest
+    /// of the archive cannot refer to; kept for reuse beyond m_payload_depth
+    std::vector<detail::PointerMap> m_payload_pointers;
+    std::size_t m_payload_depth{0};
+    std::uint64_t m_pointer_count{0};
 
     OutSerializer m_serializer;
+    /// the serializer records an index, which needs pointer and element events
+    bool m_indexed;
+    /// the serializer writes tagged fields, which need field events
+    bool m_tagged;
+    /// polymorphic types are written as BinaryOptions::type_ids
+    bool m_type_ids;
+    struct WrittenType {
+        std::uint32_t id;
+        const std::function<void(void *, OutArchive &)> *serializer;
+    };
+    /// dictionary of the polymorphic types written so far, the innermost
+    /// Lazy payload's last
+    std::vector<std::unordered_map<std::type_index, WrittenType>> m_types;
 
 public:
     using TSerializer = OutSerializer;
@@ -67,7 +93,11 @@ public:
     static constexpr bool IsInput() { return false; }
 
     template <typename... Args>
-    OutArchive(Args &&...args) : m_serializer(std::forward<Args>(args)...)
+    OutArchive(Args &&...args)
+        : m_serializer(std::forward<Args>(args)...),
+          m_indexed(m_serializer.IsIndexed()),
+          m_tagged(m_serializer.IsTagged()),
+          m_type_ids(m_serializer.UsesTypeIds()), m_types(1)
     {
     }
 
@@ -75,6 +105,36 @@ public:
 
     bool IsBinary() const { return m_serializer.IsBinary(); }
 
+    /// makes room for `n` objects written through pointers, e.g. the
+    /// PointerCount() of a SizeArchive pass, so tracking them never rehashes
+    void ReservePointers(std::size_t n) { m_pointers.Reserve(n); }
+
+    /// number of objects written through pointers so far
+    std::uint64_t PointerCount() const { return m_pointer_count; }
+
+    /**
+     * @brief Starts a new archive after the one written so far, e.g. the
+     * next message on a stream; see Rebind() to switch the target.
+     *
+     * Pointer and type tables are cleared but keep their capacity, as do
+     * the serializer's buffers, so an archive reused for many messages of
+     * similar shape stops allocating. Flush() the previous archive first.
+     */
+    void Reset()
+    {
+        clearTables();
+        m_serializer.Reset();
+    }
+
+    /// Reset() on the sink made from `target`, e.g. another byte buffer or
+    /// stream of the same kind as the current one
+    template <typename T>
+    void Rebind(T &&target)
+    {
+        clearTables();
+        m_serializer.Rebind(std::forward<T>(target));
+    }
+
     void operator()(auto &&item1, auto &&...items)
     {
         process(make_nvp(item1));
@@ -83,11 +143,20 @@ public:
         }
     }
 
+protected:
+    OutSerializer &Serializer() { return m_serializer; }
+
 private:
     template <typename T>
     void process(const NamedValuePair<T> &item)
     {
         m_serializer.SetNextName(item.name);
+        if (m_tagged) {
+            m_serializer.BeginField(item.name, item.id);
+            process(item.value);
+            m_serializer.FinishField();
+            return;
+        }
         process(item.value);
     }
 
@@ -123,6 +192,36 @@ private:
 
     void process(const std::string &item) { m_serializer(item); }
 
+    void process(const std::pmr::string &item)
+    {
+        m_serializer(std::string_view(item));
+    }
+
+    void process(const std::string_view &item) { m_serializer(item); }
+
+    void process(const BorrowedBlob &item)
+    {
+        auto ptr = reinterpret_cast<const char *>(item.bytes.data());
+        m_serializer(RangeSize(item.bytes.size()));
+        m_serializer(std::span<const char>(ptr, item.bytes.size()));
+    }
+
+    template <typename T>
+    void process(const Lazy<T> &item)
+    {
+        const auto &value = item.get();
+        m_serializer.BeginPayload();
+        if (m_payload_depth == m_payload_pointers.size()) {
+            m_payload_pointers.emplace_back();
+        }
+        m_payload_pointers[m_payload_depth++].Clear();
+        m_types.emplace_back();
+        process(value);
+        m_types.pop_back();
+        --m_payload_depth;
+        m_serializer.EndPayload();
+    }
+
     template <std::ranges::range Rng>
     void processRange(const Rng &items)
     {
@@ -130,19 +229,36 @@ private:
         constexpr bool save_binary =
             std::ranges::contiguous_range<Rng> && std::is_arithmetic_v<T>;
 
+        constexpr bool maybe_bitwise = std::ranges::contiguous_range<Rng> &&
+                                       !std::is_arithmetic_v<T> &&
+                                       std::is_trivially_copyable_v<T>;
+
         std::size_t n = std::ranges::distance(items);
 
         m_serializer(RangeSize(n));
         if constexpr (save_binary) {
             if (m_serializer.IsBinary()) {
-                auto ptr = reinterpret_cast<const char *>(items.data());
-                std::span<const char> bytes(ptr, n * sizeof(T));
-                m_serializer(bytes);
+                m_serializer(std::span<const T>(items.data(), n));
+                return;
+            }
+        } else if constexpr (maybe_bitwise) {
+            if (n > 0 && m_serializer.SupportsBulkCopy() &&
+                IsBitwiseSerializable(*std::ranges::data(items))) {
+                auto ptr = reinterpret_cast<const char *>(std::ranges::data(items));
+                m_serializer(std::span<const char>(ptr, n * sizeof(T)));
                 return;
             }
         }
 
         NewObjectScope<true, TSerializer> scope(m_serializer);
+        if (m_indexed && m_serializer.IndexesElements(n)) {
+            std::size_t index = 0;
+            for (const auto &i : items) {
+                m_serializer.NextElement(index++);
+                process(i);
+            }
+            return;
+        }
         for (const auto &i : items) {
             process(i);
         }
@@ -170,40 +286,141 @@ private:
         requires std::is_pointer_v<T>
     void process(const T &item)
     {
-        auto id = reinterpret_cast<std::uintptr_t>(item);
         NewObjectScope<false, TSerializer> scope(m_serializer);
-        process(NVP(id));
-        if (id == 0) {
-            return;
-        }
-
-        if (m_pointers.contains(id)) {
+        const void *address = item;
+        auto id = findPointer(address);
+        if (item == nullptr || id != 0) {
+            process(NVP(id));
+            if (m_indexed && id != 0) {
+                m_serializer.NotePointer(id, false);
+            }
             return;
         }
         constexpr bool is_polymorphic =
             std::is_polymorphic_v<std::remove_pointer_t<T>>;
 
-        m_pointers.insert(id);
+        id = ++m_pointer_count;
+        auto &pointers = m_payload_depth == 0
+                             ? m_pointers
+                             : m_payload_pointers[m_payload_depth - 1];
+        pointers.Insert(address, id);
+        process(NVP(id));
+        if (m_indexed) {
+            m_serializer.NotePointer(id, true);
+        }
         if constexpr (!is_polymorphic) {
             process(make_nvp("data", *item));
             return;
         } else {
-            const auto &type_name = GetClassName(typeid(*item));
-            process(make_nvp("type_name", type_name));
-            const auto &serializer = GetSerializer(type_name);
+            const auto &serializer = processType(typeid(*item));
             m_serializer.SetNextName("data");
-            NewObjectScope<false, TSerializer> scope2(m_serializer);
-            serializer(item, *this);
+            if (m_tagged) {
+                m_serializer.BeginField("data", 0);
+            }
+            {
+                NewObjectScope<false, TSerializer> scope2(m_serializer);
+                serializer(item, *this);
+            }
+            if (m_tagged) {
+                m_serializer.FinishField();
+            }
+        }
+    }
+
+    /// id of an object written before that the current payload can refer to,
+    /// 0 if there is none
+    std::uint64_t findPointer(const void *address) const
+    {
+        auto id = m_pointers.Find(address);
+        if (id == 0 && m_payload_depth > 0) {
+            id = m_payload_pointers[m_payload_depth - 1].Find(address);
+        }
+        return id;
+    }
+
+    void clearTables()
+    {
+        m_pointers.Clear();
+        m_payload_depth = 0;
+        m_pointer_count = 0;
+        m_types.resize(1);
+        m_types.front().clear();
+    }
+
+    /// writes the dynamic type of a polymorphic pointer: its name, or its
+    /// index in the dictionary, followed by the name for new types
+    const std::function<void(void *, OutArchive &)> &
+    processType(const std::type_info &type)
+    {
+        if (!m_type_ids) {
+            const auto &type_name = GetClassName(type);
+            process(make_nvp("type_name", type_name));
+            return GetSerializer(type_name);
         }
+        auto &types = m_types.back();
+        if (auto it = types.find(type); it != types.end()) {
+            process(make_nvp("type", it->second.id));
+            return *it->second.serializer;
+        }
+        const auto &type_name = GetClassName(type);
+        WrittenType written{static_cast<std::uint32_t>(types.size()),
+                            &GetSerializer(type_name)};
+        types.emplace(type, written);
+        process(make_nvp("type", written.id));
+        process(make_nvp("type_name", type_name));
+        return *written.serializer;
     }
 };
 
+/**
+ * @brief Input archive.
+ *
+ * Borrowed members (std::string_view, std::span<const T> of arithmetic T and
+ * BorrowedBlob) are loaded without copying: they point into the memory the
+ * archive reads from and stay valid only as long as that memory does.
+ * - With BufferBinaryDeserializer they point into the caller's buffer, which
+ *   must outlive the loaded objects; the archive itself may be destroyed.
+ *   std::span<const T> additionally requires the payload to be suitably
+ *   aligned for T inside the buffer, otherwise loading throws.
+ * - With JsonDeserializer only std::string_view is supported; it points into
+ *   the parsed document and dies with the archive.
+ * - Stream backed binary archives cannot borrow and throw.
+ */
 class InArchive : public ArchiveBase
 {
-    std::map<void *, std::shared_ptr<void>> m_shared_pointers;
-    std::map<std::uintptr_t, void *> m_raw_pointers;
+    struct PointerEntry {
+        void *object{nullptr};
+        /// set if the object was read into a shared_ptr
+        std::shared_ptr<void> owner;
+    };
+    /// entry of pointer id i + 1, see OutArchive::m_pointers. Ids are unique
+    /// across the archive, Lazy payloads included, so payloads decoded later
+    /// resolve theirs in the same table
+    std::vector<PointerEntry> m_pointers;
 
     InDeserializer m_serializer;
+    /// fields are looked up by id and may be missing
+    bool m_tagged;
+    /// polymorphic types are read as BinaryOptions::type_ids
+    bool m_type_ids;
+    /// handles of a polymorphic type read from the archive
+    struct ReadType {
+        std::string name;
+        const std::function<void *()> *constructor{nullptr};
+        const std::function<std::shared_ptr<void>(std::pmr::memory_resource *)>
+            *shared_constructor{nullptr};
+        const std::function<void(void *, InArchive &)> *deserializer{nullptr};
+    };
+    /// dictionary of the polymorphic types read so far, and the one of the
+    /// Lazy payload being decoded
+    std::vector<ReadType> m_types;
+    std::vector<ReadType> *m_payload_types{nullptr};
+    /// type of the last pointer read without type ids
+    ReadType m_named_type;
+    /// memory of the objects read into shared_ptrs, nullptr for the heap
+    std::pmr::memory_resource *m_resource{nullptr};
+    /// std::pmr::string values are read through it
+    std::string m_string;
 
     InArchive(const InArchive &) = delete;
 
@@ -213,12 +430,64 @@ public:
     static constexpr bool IsInput() { return true; }
 
     template <typename... Args>
-    InArchive(Args &&...args) : m_serializer(std::forward<Args>(args)...)
+    InArchive(Args &&...args)
+        : m_serializer(std::forward<Args>(args)...),
+          m_tagged(m_serializer.IsTagged()),
+          m_type_ids(m_serializer.UsesTypeIds())
     {
     }
 
     bool IsBinary() const { return m_serializer.IsBinary(); }
 
+    /// makes room for `n` objects read through pointers, see
+    /// OutArchive::PointerCount()
+    void ReservePointers(std::size_t n) { m_pointers.reserve(n); }
+
+    /**
+     * @brief Creates the objects read into std::shared_ptr, and their
+     * control blocks, in `resource` instead of on the heap.
+     *
+     * With a std::pmr::monotonic_buffer_resource a graph is laid out in the
+     * order it is read and released at once. The resource must outlive the
+     * loaded pointers. Allocator-aware types get the resource as their
+     * allocator (see Access::CreateShared()) and elements of pmr containers
+     * are built with the container's allocator. Objects owned by
+     * std::unique_ptr or raw pointers stay on the heap, where their owners
+     * delete them. Polymorphic types need REGISTER_CLASS, or a constructor
+     * from ArchiveBase::RegisterSharedConstructor(), to be created in the
+     * resource and fall back to the heap otherwise.
+     */
+    void SetMemoryResource(std::pmr::memory_resource *resource)
+    {
+        m_resource = resource;
+    }
+
+    std::pmr::memory_resource *GetMemoryResource() const { return m_resource; }
+
+    /**
+     * @brief Starts reading a new archive at the current position of the
+     * source, e.g. the next message on a stream; see Rebind() to switch the
+     * source.
+     *
+     * Tables keep their capacity like OutArchive::Reset(). Lazy members of
+     * the previous archive that were not loaded yet cannot be loaded
+     * afterwards.
+     */
+    void Reset()
+    {
+        clearTables();
+        m_serializer.Reset();
+    }
+
+    /// Reset() on the source made from `target`, e.g. another byte buffer
+    /// or stream of the same kind as the current one
+    template <typename T>
+    void Rebind(T &&target)
+    {
+        clearTables();
+        m_serializer.Rebind(std::forward<T>(target));
+    }
+
     void operator()(auto &&item1, auto &&...items)
     {
         process(make_nvp(item1));
@@ -227,18 +496,91 @@ public:
         }
     }
 
+    /**
+     * @brief Positions the archive at the top-level entry `name`, which is
+     * then read as usual: `iar.Seek("header")(make_nvp("header", header))`.
+     *
+     * Binary archives must be written with BinaryOptions::indexed and read
+     * from a seekable source; entries referencing pointers first written by
+     * an earlier entry throw. Json archives look entries up by name anyway.
+     */
+    InArchive &Seek(std::string_view name)
+    {
+        m_serializer.Seek(name);
+        return *this;
+    }
+
+    /**
+     * @brief Loads `count` elements starting at `first` of the top-level
+     * range `name` into `items`, fewer if the range ends before.
+     *
+     * Indexed binary archives jump to the chunk containing `first` (or
+     * straight to it for fixed width arithmetic elements) and only decode
+     * from there; other formats walk the range from its start.
+     */
+    template <typename T>
+    void LoadRange(std::string_view name, std::size_t first, std::size_t count,
+                   std::vector<T> &items)
+    {
+        items.clear();
+        if (auto seek = m_serializer.template SeekRange<T>(name, first)) {
+            auto [n, start] = *seek;
+            loadElements(items, start, first, std::min(n, first + count));
+            return;
+        }
+        m_serializer.SetNextName(name);
+        NewObjectScope<true, TSerializer> scope(m_serializer);
+        RangeSize sn(0);
+        m_serializer(sn);
+        loadElements(items, 0, first,
+                     std::min<std::size_t>(sn.size, first + count));
+    }
+
 private:
+    /// reads the elements [start, last) the source is positioned at and
+    /// keeps those from `first` on
+    template <typename T>
+    void loadElements(std::vector<T> &items, std::size_t start,
+                      std::size_t first, std::size_t last)
+    {
+        if (last <= first) {
+            return;
+        }
+        if constexpr (std::is_arithmetic_v<T> && !std::same_as<T, bool>) {
+            if (start == first && m_serializer.IsBinary()) {
+                items.resize(last - first);
+                m_serializer(std::span<T>(items));
+                return;
+            }
+        }
+        items.reserve(last - first);
+        for (auto i = start; i < last; ++i) {
+            T item;
+            process(item);
+            if (i >= first) {
+                items.push_back(std::move(item));
+            }
+        }
+    }
+
     template <typename T>
     void process(NamedValuePair<T> &&item)
     {
-        m_serializer.SetNextName(item.name);
-        process(item.value);
+        process(item);
     }
 
+    /// fields missing from tagged archives keep their current value
     template <typename T>
     void process(NamedValuePair<T> &item)
     {
         m_serializer.SetNextName(item.name);
+        if (m_tagged) {
+            if (m_serializer.BeginField(item.name, item.id)) {
+                process(item.value);
+                m_serializer.FinishField();
+            }
+            return;
+        }
         process(item.value);
     }
 
@@ -257,10 +599,11 @@ private:
         } else if constexpr (std::is_pointer_v<T>) {
             processPointer(item);
         } else if constexpr (requires(T t) { t.serialize(*this); }) {
-            NewObjectScope<is_range, TSerializer> scope(m_serializer);
+            // an object whatever T is, like OutArchive writes it
+            NewObjectScope<false, TSerializer> scope(m_serializer);
             item.serialize(*this);
         } else if constexpr (requires(T t) { serialize(t, *this); }) {
-            NewObjectScope<is_range, TSerializer> scope(m_serializer);
+            NewObjectScope<false, TSerializer> scope(m_serializer);
             serialize(item, *this);
         } else if constexpr (is_range) {
             processRange(item);
@@ -274,6 +617,72 @@ private:
 
     void process(std::string &item) { m_serializer(item); }
 
+    void process(std::pmr::string &item)
+    {
+        m_serializer(m_string);
+        item.assign(m_string);
+    }
+
+    void process(std::string_view &item) { m_serializer(item); }
+
+    void process(BorrowedBlob &item) { m_serializer(item); }
+
+    template <typename T>
+    void process(Lazy<T> &item)
+    {
+        auto payload = m_serializer.SkipPayload();
+        if (!payload.deferred) {
+            T value{};
+            loadPayload(payload, value);
+            item = std::move(value);
+            return;
+        }
+        item.Defer([this, payload = std::move(payload)](T &value) {
+            loadPayload(payload, value);
+        });
+    }
+
+    template <typename T>
+    void loadPayload(const detail::LazyPayload &payload, T &value)
+    {
+        std::vector<ReadType> types;
+        auto outer_types = std::exchange(m_payload_types, &types);
+        auto pos = m_serializer.ResumePayload(payload);
+        Scope scope([&, outer_types] { m_payload_types = outer_types; });
+        process(value);
+        m_serializer.LeavePayload(payload, pos);
+    }
+
+    void clearTables()
+    {
+        m_pointers.clear();
+        m_types.clear();
+        m_payload_types = nullptr;
+    }
+
+    void *findPointer(std::uint64_t id) const
+    {
+        return id <= m_pointers.size() ? m_pointers[id - 1].object : nullptr;
+    }
+
+    PointerEntry &definePointer(std::uint64_t id, void *ptr)
+    {
+        // entries read out of order (Seek(), LoadRange()) leave gaps
+        if (id > m_pointers.size()) {
+            m_pointers.resize(id);
+        }
+        auto &entry = m_pointers[id - 1];
+        entry.object = ptr;
+        return entry;
+    }
+
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    void process(std::span<const T> &item)
+    {
+        m_serializer(item);
+    }
+
     template <typename T>
     void process(BaseClass<T> &item)
     {
@@ -287,7 +696,31 @@ private:
         constexpr bool save_binary =
             std::ranges::contiguous_range<Rng> && std::is_arithmetic_v<T>;
 
+        constexpr bool maybe_bitwise = std::ranges::contiguous_range<Rng> &&
+                                       !std::is_arithmetic_v<T> &&
+                                       std::is_trivially_copyable_v<T>;
+
         RangeSize sn(0);
+        if constexpr (maybe_bitwise) {
+            // binary formats that allow raw copies have no array scopes, so the
+            // size can be read up front for both the bulk and the element path
+            if (m_serializer.SupportsBulkCopy()) {
+                m_serializer(sn);
+                std::size_t n = sn.size;
+                if constexpr (requires { items.resize(n); }) {
+                    items.resize(n);
+                }
+                if (n > 0 && IsBitwiseSerializable(*std::ranges::data(items))) {
+                    auto ptr = reinterpret_cast<char *>(std::ranges::data(items));
+                    m_serializer(std::span<char>(ptr, n * sizeof(T)));
+                } else {
+                    for (auto &i : items) {
+                        process(i);
+                    }
+                }
+                return;
+            }
+        }
         if constexpr (save_binary) {
             if (m_serializer.IsBinary()) {
                 m_serializer(sn);
@@ -296,9 +729,7 @@ private:
                 if constexpr (requires { items.resize(n); }) {
                     items.resize(n);
                 }
-                auto ptr = reinterpret_cast<char *>(items.data());
-                std::span<char> span(ptr, n * sizeof(T));
-                m_serializer(span);
+                m_serializer(std::span<T>(items.data(), n));
                 return;
             }
         }
@@ -316,9 +747,9 @@ private:
 
         if constexpr (requires { typename Rng::mapped_type; }) {
             for (std::size_t i = 0; i < n; ++i) {
-                typename std::pair<typename Rng::key_type,
-                                   typename Rng::mapped_type>
-                    item;
+                auto item = makeElement<std::pair<typename Rng::key_type,
+                                                  typename Rng::mapped_type>>(
+                    items);
                 process(item);
                 items.emplace(std::move(item));
             }
@@ -328,7 +759,7 @@ private:
                                  items.emplace(std::declval<T>());
                              }) {
             for (std::size_t i = 0; i < n; ++i) {
-                typename Rng::value_type item;
+                auto item = makeElement<typename Rng::value_type>(items);
                 process(item);
                 items.emplace(std::move(item));
             }
@@ -345,6 +776,23 @@ private:
         }
     }
 
+    /// element to be inserted into `items`, built with the allocator of
+    /// pmr containers so that it is moved in without a copy
+    template <typename T, typename Rng>
+    static T makeElement(const Rng &items)
+    {
+        if constexpr (requires {
+                          requires std::same_as<
+                              typename Rng::allocator_type,
+                              std::pmr::polymorphic_allocator<
+                                  typename Rng::value_type>>;
+                      }) {
+            return std::make_obj_using_allocator<T>(items.get_allocator());
+        } else {
+            return T{};
+        }
+    }
+
     template <typename T>
     void process(std::unique_ptr<T> &item)
     {
@@ -365,59 +813,138 @@ private:
     void process(std::shared_ptr<T> &item)
     {
         T *ptr;
-        processPointer<std::add_pointer_t<T>, true>(ptr);
+        auto id = processPointer<std::add_pointer_t<T>, true>(ptr);
         if (ptr == nullptr) {
             item.reset();
             return;
         }
 
-        if (m_shared_pointers.contains(ptr)) {
-            item = std::static_pointer_cast<T>(m_shared_pointers[ptr]);
-            return;
-        } else {
+        const auto &owner = m_pointers[id - 1].owner;
+        if (!owner) {
             ZEN_THROW("shared_ptr not found");
         }
+        item = std::static_pointer_cast<T>(owner);
     }
 
+    /// returns the pointer id
     template <typename T, bool IsShared = false>
         requires std::is_pointer_v<T>
-    void processPointer(T &ptr)
+    std::uint64_t processPointer(T &ptr)
     {
-        std::uintptr_t id;
+        std::uint64_t id = 0;
         NewObjectScope<false, TSerializer> scope(m_serializer);
         auto nvp = make_nvp("id", id);
         process(nvp);
         if (id == 0) {
             ptr = nullptr;
-            return;
+            return id;
         }
-        if (m_raw_pointers.contains(id)) {
-            ptr = static_cast<T>(m_raw_pointers[id]);
-            return;
+        if (auto found = findPointer(id)) {
+            ptr = static_cast<T>(found);
+            return id;
         }
 
         using TVal = std::remove_pointer_t<T>;
 
         if constexpr (!std::is_polymorphic_v<TVal>) {
-            ptr = Access::Create<TVal>();
-            m_raw_pointers[id] = ptr;
-            if constexpr (IsShared) {
-                m_shared_pointers[ptr] = std::shared_ptr<TVal>(ptr);
-            }
+            ptr = createObject<TVal, IsShared>(id, nullptr);
             process(make_nvp("data", *ptr));
         } else {
-            std::string type_name;
-            process(make_nvp("type_name", type_name));
-            ptr = Create<TVal>(type_name);
-            m_raw_pointers[id] = ptr;
-            if constexpr (IsShared) {
-                m_shared_pointers[ptr] = std::shared_ptr<TVal>(ptr);
+            // nested pointers may add types, the entry can move
+            const auto &type = processType();
+            const auto &deserializer = *type.deserializer;
+            if (m_tagged) {
+                ZEN_ENSURE_WITH_MSG(m_serializer.BeginField("data", 0),
+                                    fmt::format("No data for pointer of {}",
+                                                type.name));
             }
-            const auto &deserializer = GetDeserializer(type_name);
+            ptr = createObject<TVal, IsShared>(id, &type);
             m_serializer.SetNextName("data");
-            NewObjectScope<false, TSerializer> scope2(m_serializer);
-            deserializer(ptr, *this);
+            {
+                NewObjectScope<false, TSerializer> scope2(m_serializer);
+                deserializer(ptr, *this);
+            }
+            if (m_tagged) {
+                m_serializer.FinishField();
+            }
+        }
+        return id;
+    }
+
+    /// creates the object of pointer `id`, of `type` if it is polymorphic
+    template <typename TVal, bool IsShared>
+    TVal *createObject(std::uint64_t id, const ReadType *type)
+    {
+        auto &entry = definePointer(id, nullptr);
+        if constexpr (IsShared) {
+            if (m_resource) {
+                if constexpr (!std::is_polymorphic_v<TVal>) {
+                    entry.owner = Access::CreateShared<TVal>(m_resource);
+                } else if (type->shared_constructor) {
+                    entry.owner = (*type->shared_constructor)(m_resource);
+                }
+            }
+            if (entry.owner) {
+                entry.object = entry.owner.get();
+                return static_cast<TVal *>(entry.object);
+            }
+        }
+        TVal *ptr;
+        if constexpr (!std::is_polymorphic_v<TVal>) {
+            ptr = Access::Create<TVal>();
+        } else {
+            ptr = static_cast<TVal *>((*type->constructor)());
+        }
+        entry.object = ptr;
+        if constexpr (IsShared) {
+            entry.owner = std::shared_ptr<TVal>(ptr);
+        }
+        return ptr;
+    }
+
+    /// reads the dynamic type of a polymorphic pointer, see
+    /// OutArchive::processType()
+    const ReadType &processType()
+    {
+        if (!m_type_ids) {
+            std::string type_name;
+            process(make_nvp("type_name", type_name));
+            m_named_type = resolveType(std::move(type_name));
+            return m_named_type;
+        }
+        auto &types = m_payload_types ? *m_payload_types : m_types;
+        std::uint32_t id = 0;
+        process(make_nvp("type", id));
+        if (id < types.size()) {
+            return types[id];
+        }
+        ZEN_ENSURE_WITH_MSG(id == types.size(),
+                            fmt::format("Type id {} is not in the dictionary "
+                                        "of {} types",
+                                        id, types.size()));
+        std::string type_name;
+        process(make_nvp("type_name", type_name));
+        return types.emplace_back(resolveType(std::move(type_name)));
+    }
+
+    static ReadType resolveType(std::string type_name)
+    {
+        ReadType type{std::move(type_name)};
+        if (type.name.empty()) {
+            ZEN_THROW("Class name is empty");
+        }
+        try {
+            type.constructor = &GetConstructor(type.name);
+            type.shared_constructor = FindSharedConstructor(type.name);
+            type.deserializer = &GetDeserializer(type.name);
+        } catch (...) {
+        }
+        if (!type.constructor || !*type.constructor) {
+            ZEN_THROW(fmt::format("No constructor for {}", type.name));
         }
+        ZEN_ENSURE_WITH_MSG(type.deserializer != nullptr,
+                            fmt::format("No deserializer for {}", type.name));
+        return type;
     }
 };
 } // namespace zen
@@ -11,12 +11,16 @@
 
 #include <zen_serialization_export.h>
 
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <ranges>
 #include <set>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <typeindex>
 #include <variant>
 
@@ -34,7 +38,7 @@
     macro(a1) __VA_OPT__(, FOR_EACH_AGAIN PARENS(macro, __VA_ARGS__))
 #define FOR_EACH_AGAIN() FOR_EACH_HELPER
 
-#define NVP(x) zen::make_nvp(#x, x)
+#define NVP(x) zen::make_nvp(zen::FieldName(#x), x)
 
 #define SERIALIZE_MEMBER(...)                                                  \
     friend class zen::Access;                                                  \
@@ -76,10 +80,35 @@ namespace zen
 class OutArchive;
 class InArchive;
 
+/// Id of a field in tagged binary archives: the 32 bit FNV-1a hash of its
+/// name, 0 is reserved for "not computed yet"
+constexpr std::uint32_t FieldId(std::string_view name)
+{
+    std::uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash = (hash ^ static_cast<std::uint8_t>(c)) * 16777619u;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+/// NVP name whose field id is computed at compile time
+struct FieldName {
+    std::string_view name;
+    std::uint32_t id;
+
+    template <std::size_t N>
+    explicit consteval FieldName(const char (&str)[N])
+        : name(str, N - 1), id(FieldId(name))
+    {
+    }
+};
+
 template <typename T>
 struct NamedValuePair {
     std::string name;
     T value;
+    /// FieldId(name) if known in advance, otherwise 0
+    std::uint32_t id{0};
 };
 
 template <typename T>
@@ -106,6 +135,13 @@ NamedValuePair<T> make_nvp(std::string name, T &&value)
     return NamedValuePair<T>{std::move(name), std::forward<T>(value)};
 }
 
+template <typename T>
+NamedValuePair<T> make_nvp(FieldName name, T &&value)
+{
+    return NamedValuePair<T>{std::string(name.name), std::forward<T>(value),
+                             name.id};
+}
+
 template <typename T>
 struct BaseClass {
     const T *ptr;
@@ -125,6 +161,50 @@ public:
     {
         return new T;
     }
+
+    /**
+     * @brief Creates a T in memory of `resource`, together with the control
+     * block of the returned pointer, which destroys it and hands the memory
+     * back to `resource`.
+     *
+     * Allocator-aware types (std::uses_allocator) are constructed with the
+     * resource, so their pmr members allocate from it too.
+     */
+    template <typename T>
+    static std::shared_ptr<T> CreateShared(std::pmr::memory_resource *resource)
+    {
+        std::pmr::polymorphic_allocator<T> allocator(resource);
+        T *ptr = allocator.allocate(1);
+        try {
+            if constexpr (std::uses_allocator_v<T, decltype(allocator)>) {
+                std::apply(
+                    [ptr](auto &&...args) {
+                        ::new (static_cast<void *>(ptr))
+                            T(std::forward<decltype(args)>(args)...);
+                    },
+                    std::uses_allocator_construction_args<T>(allocator));
+            } else {
+                ::new (static_cast<void *>(ptr)) T;
+            }
+        } catch (...) {
+            allocator.deallocate(ptr, 1);
+            throw;
+        }
+        return std::shared_ptr<T>(ptr, ResourceDeleter<T>{resource},
+                                  allocator);
+    }
+
+private:
+    template <typename T>
+    struct ResourceDeleter {
+        std::pmr::memory_resource *resource;
+
+        void operator()(T *ptr) const
+        {
+            ptr->~T();
+            std::pmr::polymorphic_allocator<T>(resource).deallocate(ptr, 1);
+        }
+    };
 };
 
 struct ZEN_SERIALIZATION_EXPORT ArchiveBase {
@@ -161,6 +241,11 @@ struct ZEN_SERIALIZATION_EXPORT ArchiveBase {
     {
         RegisterConstructor(GetClassName<T>(),
                             []() -> void * { return Access::Create<T>(); });
+        RegisterSharedConstructor(
+            GetClassName<T>(),
+            [](std::pmr::memory_resource *resource) -> std::shared_ptr<void> {
+                return Access::CreateShared<T>(resource);
+            });
     }
 
     static void RegisterConstructor(const std::string &name,
@@ -169,6 +254,18 @@ struct ZEN_SERIALIZATION_EXPORT ArchiveBase {
     static const std::function<void *()> &
     GetConstructor(const std::string &name);
 
+    /// constructor of objects in a memory resource, see
+    /// InArchive::SetMemoryResource()
+    static void RegisterSharedConstructor(
+        const std::string &name,
+        std::function<std::shared_ptr<void>(std::pmr::memory_resource *)>
+            constructor);
+
+    /// nullptr if `name` was registered without one
+    static const std::function<
+        std::shared_ptr<void>(std::pmr::memory_resource *)> *
+    FindSharedConstructor(const std::string &name);
+
     template <typename T>
     static void RegisterSerializer()
     {
@@ -0,0 +1,90 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file archive_pool.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 14:05:37, November 4, 2025
+ */
+#pragma once
+#include "archive.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace zen
+{
+
+/**
+ * @brief Thread-local binary archives reused from message to message.
+ *
+ * Every thread keeps one OutArchive and one InArchive per BinaryOptions.
+ * They are rebound to the buffer of each call (see OutArchive::Rebind()), so
+ * their tables and the serializer buffers keep their capacity and
+ * steady-state use does not allocate beyond the message itself. An archive
+ * returned by Out() or In() stays valid until the next call on the same
+ * thread with the same options.
+ *
+ *   std::vector<std::byte> message;
+ *   ArchivePool::Save(message, options, make_nvp("request", request));
+ *   ArchivePool::Load(message, options, make_nvp("request", loaded));
+ */
+class ArchivePool
+{
+public:
+    static OutArchive &Out(std::vector<std::byte> &buffer,
+                           BinaryOptions options = {})
+    {
+        auto &archive = Slot<OutArchive>(options);
+        if (!archive) {
+            archive = std::make_unique<OutArchive>(
+                BufferBinarySerializer{buffer, options});
+        } else {
+            archive->Rebind(buffer);
+        }
+        return *archive;
+    }
+
+    static InArchive &In(std::span<const std::byte> buffer,
+                         BinaryOptions options = {})
+    {
+        auto &archive = Slot<InArchive>(options);
+        if (!archive) {
+            archive = std::make_unique<InArchive>(
+                BufferBinaryDeserializer{buffer, options});
+        } else {
+            archive->Rebind(buffer);
+        }
+        return *archive;
+    }
+
+    /// serializes `items` into `buffer`, replacing its content
+    template <typename... Ts>
+    static void Save(std::vector<std::byte> &buffer, BinaryOptions options,
+                     Ts &&...items)
+    {
+        auto &oar = Out(buffer, options);
+        oar(std::forward<Ts>(items)...);
+        oar.Flush();
+    }
+
+    template <typename... Ts>
+    static void Load(std::span<const std::byte> buffer, BinaryOptions options,
+                     Ts &&...items)
+    {
+        In(buffer, options)(std::forward<Ts>(items)...);
+    }
+
+private:
+    template <typename TArchive>
+    static std::unique_ptr<TArchive> &Slot(BinaryOptions options)
+    {
+        thread_local std::array<std::unique_ptr<TArchive>, 256> archives;
+        return archives[options.Flags()];
+    }
+};
+
+} // namespace zen
@@ -0,0 +1,185 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file binary_index.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 16:20:31, October 21, 2025
+ */
+#pragma once
+#include "archive_base.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zen
+{
+
+/// Location of one top-level NVP of an indexed binary archive.
+struct IndexEntry {
+    std::string name;
+    /// byte offsets of the value and of its end, from the archive start
+    std::uint64_t offset{0};
+    std::uint64_t end{0};
+    /// the value references pointers first written by an earlier entry, so
+    /// it can only be read after them
+    bool dependent{false};
+    /// elements per chunk of a large top-level range, 0 without chunks
+    std::uint64_t stride{0};
+    /// offset of element `i * stride` for every chunk i
+    std::vector<std::uint64_t> chunks;
+    /// per chunk: references pointers of earlier chunks or entries
+    std::vector<std::uint8_t> chunk_dependent;
+};
+
+/**
+ * @brief Table of contents of an indexed binary archive.
+ *
+ * Flush() appends it as a trailer after the last entry, followed by a fixed
+ * footer (trailer offset as little endian u64, then "ZIDX"), so readers find
+ * it from the end without touching the entries. The trailer itself is
+ * little endian and independent of the archive's BinaryOptions.
+ */
+struct ZEN_SERIALIZATION_EXPORT BinaryIndex {
+    static constexpr std::array<char, 4> Magic{'Z', 'I', 'D', 'X'};
+    static constexpr std::size_t FooterSize = 8 + Magic.size();
+
+    std::vector<IndexEntry> entries;
+
+    /// first entry called `name`, nullptr if there is none
+    const IndexEntry *Find(std::string_view name) const;
+
+    /// trailer bytes followed by the footer for a trailer at `offset`
+    std::vector<std::byte> Encode(std::uint64_t offset) const;
+
+    /// parses the trailer and footer, `bytes` ending with the footer
+    static BinaryIndex Decode(std::span<const std::byte> bytes);
+
+    /// trailer offset stored in a footer
+    static std::uint64_t DecodeFooter(std::span<const std::byte> footer);
+};
+
+namespace detail
+{
+
+/// Collects the BinaryIndex while an indexed archive is written. Nesting is
+/// tracked through the serializer's object/array scopes, so names seen at
+/// depth 0 start the top-level entries.
+class IndexBuilder
+{
+public:
+    /// elements per chunk of top-level ranges with more elements than that
+    static constexpr std::size_t Stride = 1024;
+
+    const BinaryIndex &Index() const { return m_index; }
+
+    bool Finished() const { return m_finished; }
+
+    void Enter() { ++m_depth; }
+
+    void Leave()
+    {
+        if (--m_depth == 0) {
+            m_chunk_unit = 0;
+        }
+    }
+
+    void Name(std::string_view name, std::uint64_t offset);
+
+    /// whether the elements of a range of `n` should be marked
+    bool WantsElements(std::size_t n) const
+    {
+        return m_depth == 1 && !m_index.entries.empty() && n > Stride &&
+               m_index.entries.back().stride == 0;
+    }
+
+    void Element(std::size_t i, std::uint64_t offset)
+    {
+        if (i % Stride == 0) {
+            auto &entry = m_index.entries.back();
+            entry.stride = Stride;
+            entry.chunks.push_back(offset);
+            entry.chunk_dependent.push_back(0);
+            m_chunk_unit = ++m_unit;
+        }
+    }
+
+    void Pointer(std::uint64_t id, bool first);
+
+    /// closes the last entry, the archive cannot grow afterwards
+    void Finish(std::uint64_t offset);
+
+private:
+    BinaryIndex m_index;
+    std::size_t m_depth{0};
+    /// entries and chunks are numbered in order, pointers remember the unit
+    /// that wrote them first
+    std::size_t m_unit{0};
+    std::size_t m_entry_unit{0};
+    /// unit of the chunk being written, 0 outside of chunks
+    std::size_t m_chunk_unit{0};
+    /// unit of pointer id i + 1, 0 if it was written before the first entry
+    std::vector<std::size_t> m_pointer_units;
+    bool m_finished{false};
+};
+
+inline void IndexBuilder::Name(std::string_view name, std::uint64_t offset)
+{
+    if (m_depth != 0) {
+        return;
+    }
+    if (m_finished) {
+        ZEN_THROW("An indexed archive cannot be written to after Flush() "
+                  "appended its index");
+    }
+    if (!m_index.entries.empty()) {
+        m_index.entries.back().end = offset;
+    }
+    auto &entry = m_index.entries.emplace_back();
+    entry.name = name;
+    entry.offset = offset;
+    m_entry_unit = ++m_unit;
+    m_chunk_unit = 0;
+}
+
+inline void IndexBuilder::Pointer(std::uint64_t id, bool first)
+{
+    if (m_index.entries.empty()) {
+        return;
+    }
+    if (first) {
+        if (id > m_pointer_units.size()) {
+            m_pointer_units.resize(id, 0);
+        }
+        m_pointer_units[id - 1] = m_unit;
+        return;
+    }
+    auto unit = id <= m_pointer_units.size() ? m_pointer_units[id - 1] : 0;
+    if (unit == 0) {
+        return;
+    }
+    auto &entry = m_index.entries.back();
+    if (unit < m_entry_unit) {
+        entry.dependent = true;
+    }
+    if (m_chunk_unit != 0 && unit < m_chunk_unit) {
+        entry.chunk_dependent.back() = 1;
+    }
+}
+
+inline void IndexBuilder::Finish(std::uint64_t offset)
+{
+    if (!m_index.entries.empty()) {
+        m_index.entries.back().end = offset;
+    }
+    m_finished = true;
+}
+
+} // namespace detail
+
+} // namespace zen
@@ -0,0 +1,99 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file binary_options.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 15:08:44, October 18, 2025
+ */
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace zen
+{
+
+/**
+ * @brief Encoding options of the binary format.
+ *
+ * The default options produce the plain fixed-width format without any
+ * header. Any other combination prefixes the archive with a BinaryHeader that
+ * records the options, and the reader has to be constructed with the same
+ * options.
+ */
+struct BinaryOptions {
+    /// LEB128 encode integers wider than one byte (zigzag for signed ones),
+    /// which covers range sizes, pointer ids, variant indices and enums
+    bool compact{false};
+
+    /// store platform dependent types with a fixed width (see
+    /// detail::portable_t) and record the writer's byte order in the header,
+    /// readers on a host of the other byte order swap while loading
+    bool portable{false};
+
+    /// append a table of contents of the top-level NVPs on Flush(), which
+    /// lets InArchive::Seek() and InArchive::LoadRange() jump straight to an
+    /// entry (see BinaryIndex)
+    bool indexed{false};
+
+    /// write every NVP with the FieldId() of its name and every object with
+    /// its length and a directory of its fields, so readers match fields by
+    /// id, skip unknown ones and leave missing ones untouched; needs a
+    /// seekable source to read
+    bool tagged{false};
+
+    /// write every distinct string once and refer to it by a varint id
+    /// afterwards; Lazy payloads have tables of their own. Not available with
+    /// indexed or tagged archives, whose parts are read out of order
+    bool string_table{false};
+
+    /// write polymorphic pointers with the index of their type in a
+    /// dictionary of the types used so far instead of the type name, the
+    /// first pointer of a type adds it with its name; same restrictions as
+    /// string_table
+    bool type_ids{false};
+
+    bool operator==(const BinaryOptions &) const = default;
+
+    std::uint8_t Flags() const
+    {
+        std::uint8_t flags = 0;
+        flags |= compact ? CompactFlag : 0;
+        flags |= portable ? PortableFlag : 0;
+        flags |= indexed ? IndexedFlag : 0;
+        flags |= tagged ? TaggedFlag : 0;
+        flags |= string_table ? StringTableFlag : 0;
+        flags |= type_ids ? TypeIdsFlag : 0;
+        return flags;
+    }
+
+    static BinaryOptions FromFlags(std::uint8_t flags)
+    {
+        return BinaryOptions{.compact = (flags & CompactFlag) != 0,
+                             .portable = (flags & PortableFlag) != 0,
+                             .indexed = (flags & IndexedFlag) != 0,
+                             .tagged = (flags & TaggedFlag) != 0,
+                             .string_table = (flags & StringTableFlag) != 0,
+                             .type_ids = (flags & TypeIdsFlag) != 0};
+    }
+
+    static constexpr std::uint8_t CompactFlag = 1 << 0;
+    static constexpr std::uint8_t PortableFlag = 1 << 1;
+    static constexpr std::uint8_t IndexedFlag = 1 << 2;
+    static constexpr std::uint8_t TaggedFlag = 1 << 3;
+    static constexpr std::uint8_t StringTableFlag = 1 << 4;
+    static constexpr std::uint8_t TypeIdsFlag = 1 << 5;
+    /// not an option: set in the header when a portable archive was written
+    /// on a big-endian host
+    static constexpr std::uint8_t BigEndianFlag = 1 << 7;
+    static constexpr bool NativeBigEndian =
+        std::endian::native == std::endian::big;
+};
+
+struct BinaryHeader {
+    static constexpr std::array<char, 4> Magic{'Z', 'E', 'N', 'B'};
+    static constexpr std::uint8_t Version = 1;
+};
+
+} // namespace zen
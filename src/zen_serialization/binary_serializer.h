@@ -7,93 +7,1196 @@
  * @date: 18:50:48, September 18, 2025
  */
 #pragma once
+#include "binary_index.h"
+#include "binary_options.h"
+#include "borrowed_blob.h"
+#include "byteswap.h"
+#include "lazy.h"
 #include "range_size.h"
+#include "sink.h"
+#include "source.h"
+#include "varint.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <span>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace zen
 {
+namespace detail
+{
+/// id of a field of a tagged archive, unnamed fields are numbered per object
+/// like json does
+inline std::uint32_t ResolveFieldId(std::string_view name, std::uint32_t id,
+                                    std::uint32_t &unnamed)
+{
+    if (id != 0) {
+        return id;
+    }
+    if (name.empty()) {
+        return FieldId(fmt::format("value{}", unnamed++));
+    }
+    return FieldId(name);
+}
+
+/// string and type ids only make sense when an archive is read in order
+inline void CheckInOrderOptions(const BinaryOptions &options)
+{
+    ZEN_ENSURE_WITH_MSG(!(options.string_table || options.type_ids) ||
+                            (!options.indexed && !options.tagged),
+                        "BinaryOptions::string_table and type_ids cannot be "
+                        "combined with indexed or tagged archives")
+}
+
+struct StringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const
+    {
+        return std::hash<std::string_view>{}(str);
+    }
+};
+} // namespace detail
 
-class BinarySerializer
+template <Sink TSink>
+class BasicBinarySerializer
 {
-    std::ostream &m_stream;
+    TSink m_sink;
+    BinaryOptions m_options;
+    /// bytes written so far, including the header
+    std::uint64_t m_offset{0};
+    std::unique_ptr<detail::IndexBuilder> m_index;
+    /// Lazy payloads and tagged objects/fields being written. Their bytes
+    /// are buffered one after another in m_scratch until their length is
+    /// known, then their header is inserted in front of them; kept across
+    /// payloads so the buffers are reused
+    struct Payload {
+        /// where the payload starts in m_scratch
+        std::size_t start{0};
+        std::uint64_t size{0};
+        /// tagged object: its fields are listed in a directory
+        bool object{false};
+        std::vector<std::pair<std::uint32_t, std::uint64_t>> fields;
+        std::uint32_t unnamed{0};
+    };
+    std::vector<Payload> m_payloads;
+    std::size_t m_payload_depth{0};
+    /// kept at its capacity like BufferSink, m_scratch_size bytes are used
+    std::vector<std::byte> m_scratch;
+    std::size_t m_scratch_size{0};
+    std::vector<std::byte> m_directory;
+    /// open fields of a tagged archive: start inside the object payload, or
+    /// std::nullopt for fields framed on their own (top-level, Lazy payloads)
+    std::vector<std::optional<std::uint64_t>> m_fields;
+    std::uint32_t m_unnamed{0};
+    /// ids of the strings written so far, the innermost Lazy payload's last
+    std::vector<std::unordered_map<std::string, std::uint64_t,
+                                   detail::StringHash, std::equal_to<>>>
+        m_strings;
+    std::size_t m_string_depth{0};
 
 public:
     static constexpr bool IsBinary() { return true; }
 
-    BinarySerializer(std::ostream &stream) : m_stream(stream) {}
+    explicit BasicBinarySerializer(TSink sink, BinaryOptions options = {})
+        : m_sink(std::move(sink)), m_options(options)
+    {
+        detail::CheckInOrderOptions(m_options);
+        Reset();
+    }
+
+    /// starts a new archive after the bytes written so far, e.g. the next
+    /// message on a stream; internal buffers keep their capacity
+    void Reset()
+    {
+        m_offset = 0;
+        m_payload_depth = 0;
+        m_scratch_size = 0;
+        m_fields.clear();
+        m_unnamed = 0;
+        m_string_depth = 0;
+        if (m_options.string_table) {
+            if (m_strings.empty()) {
+                m_strings.resize(1);
+            }
+            m_strings.front().clear();
+        }
+        if (m_options.indexed) {
+            m_index = std::make_unique<detail::IndexBuilder>();
+        }
+        if (m_options != BinaryOptions{}) {
+            WriteHeader();
+        }
+    }
+
+    /// starts a new archive on `sink`, the old one is destroyed, which
+    /// flushes sinks that buffer
+    void Rebind(TSink sink)
+        requires std::is_nothrow_move_constructible_v<TSink>
+    {
+        std::destroy_at(&m_sink);
+        std::construct_at(&m_sink, std::move(sink));
+        Reset();
+    }
+
+    TSink &GetSink() { return m_sink; }
+
+    const BinaryOptions &Options() const { return m_options; }
+
+    /// tagged archives frame every object, bitwise ones included
+    bool SupportsBulkCopy() const
+    {
+        return !m_options.compact && !m_options.tagged;
+    }
+
+    /// appends the index of an indexed archive, which ends it
+    void Flush()
+    {
+        if (m_index && !m_index->Finished()) {
+            m_index->Finish(m_offset);
+            auto trailer = m_index->Index().Encode(m_offset);
+            Write(trailer.data(), trailer.size());
+        }
+        if constexpr (requires { m_sink.Flush(); }) {
+            m_sink.Flush();
+        }
+    }
+
+    bool IsIndexed() const { return m_index != nullptr; }
+
+    /// size of the index the next Flush() appends
+    std::size_t PendingIndexSize() const
+    {
+        if (!m_index || m_index->Finished()) {
+            return 0;
+        }
+        return m_index->Index().Encode(m_offset).size();
+    }
+
+    // names only matter for the index, tagged archives get them through
+    // BeginField()
+    void SetNextName(std::string_view name)
+    {
+        if (m_index) {
+            m_index->Name(name, m_offset);
+        }
+    }
+
+    void NewObject()
+    {
+        if (m_index) {
+            m_index->Enter();
+        }
+        if (m_options.tagged) {
+            PushPayload(true);
+        }
+    }
+
+    void FinishObject()
+    {
+        if (m_index) {
+            m_index->Leave();
+        }
+        if (m_options.tagged) {
+            WriteObject();
+        }
+    }
+
+    // arrays are positional even in tagged archives, their size is known
+    void NewArray()
+    {
+        if (m_index) {
+            m_index->Enter();
+        }
+    }
+
+    void FinishArray()
+    {
+        if (m_index) {
+            m_index->Leave();
+        }
+    }
+
+    bool IsTagged() const { return m_options.tagged; }
+
+    bool UsesTypeIds() const { return m_options.type_ids; }
+
+    /// starts the value of the NVP `name` in a tagged archive
+    void BeginField(std::string_view name, std::uint32_t id)
+    {
+        if (m_payload_depth > 0 && m_payloads[m_payload_depth - 1].object) {
+            auto &payload = m_payloads[m_payload_depth - 1];
+            id = detail::ResolveFieldId(name, id, payload.unnamed);
+            payload.fields.emplace_back(id, 0);
+            m_fields.emplace_back(payload.size);
+            return;
+        }
+        auto &unnamed = m_payload_depth > 0
+                            ? m_payloads[m_payload_depth - 1].unnamed
+                            : m_unnamed;
+        id = detail::ResolveFieldId(name, id, unnamed);
+        Write(&id, sizeof(id));
+        m_fields.emplace_back(std::nullopt);
+        PushPayload(false);
+    }
+
+    void FinishField()
+    {
+        auto start = m_fields.back();
+        m_fields.pop_back();
+        if (!start) {
+            WriteLengthPrefixed();
+            return;
+        }
+        auto &payload = m_payloads[m_payload_depth - 1];
+        payload.fields.back().second = payload.size - *start;
+    }
+
+    /// whether the archive reports the elements of a range of `n` through
+    /// NextElement(), which is done for large top-level ranges
+    bool IndexesElements(std::size_t n) const
+    {
+        return m_index && m_payload_depth == 0 && m_index->WantsElements(n);
+    }
+
+    void NextElement(std::size_t i) { m_index->Element(i, m_offset); }
+
+    void NotePointer(std::uint64_t id, bool first)
+    {
+        if (m_index) {
+            m_index->Pointer(id, first);
+        }
+    }
+
+    /// starts a Lazy payload, which is written length-prefixed on
+    /// EndPayload() so readers can skip it
+    void BeginPayload()
+    {
+        PushPayload(false);
+        if (m_options.string_table) {
+            // payloads may be read on their own, later or never
+            if (++m_string_depth == m_strings.size()) {
+                m_strings.emplace_back();
+            }
+            m_strings[m_string_depth].clear();
+        }
+    }
+
+    void EndPayload()
+    {
+        if (m_options.string_table) {
+            --m_string_depth;
+        }
+        WriteLengthPrefixed();
+    }
 
     void operator()(const RangeSize &size) { (*this)(size.size); }
 
-    void operator()(const std::string &str)
+    void operator()(const std::string &str) { (*this)(std::string_view(str)); }
+
+    void operator()(std::string_view str)
     {
+        if (m_options.string_table) {
+            WriteTableString(str);
+            return;
+        }
         (*this)(static_cast<uint64_t>(str.size()));
         (*this)(std::span<const char>(str));
     }
 
-    void operator()(std::span<const char> bytes)
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    void operator()(std::span<const T> items)
     {
-        auto n = static_cast<std::streamsize>(bytes.size_bytes());
-        m_stream.write(bytes.data(), n);
-
-        if (!m_stream) {
-            ZEN_THROW(fmt::format("Failed to write {} bytes to stream", n));
+        if constexpr (detail::is_varint_v<T>) {
+            if (m_options.compact) {
+                WriteVarints(items);
+                return;
+            }
         }
+        if constexpr (!detail::is_portable_layout_v<T>) {
+            if (m_options.portable) {
+                WritePortable(items);
+                return;
+            }
+        }
+        Write(items.data(), items.size_bytes());
     }
 
     template <typename T>
         requires std::is_arithmetic_v<T>
     void operator()(const T &t)
     {
-        auto ptr = reinterpret_cast<const char *>(std::addressof(t));
-        auto n = static_cast<std::streamsize>(sizeof(T));
-        m_stream.write(ptr, n);
-        if (!m_stream) {
-            ZEN_THROW(fmt::format("Failed to write {} bytes to stream", n));
+        if constexpr (detail::is_varint_v<T>) {
+            if (m_options.compact) {
+                if constexpr (CountingSink<TSink>) {
+                    Advance(
+                        detail::VarintSize(detail::ZigZagEncode(t)));
+                } else {
+                    std::byte buffer[detail::MaxVarintSize];
+                    auto n =
+                        detail::EncodeVarint(detail::ZigZagEncode(t), buffer);
+                    Write(buffer, n);
+                }
+                return;
+            }
+        }
+        if constexpr (!detail::is_portable_layout_v<T>) {
+            if (m_options.portable) {
+                auto value = static_cast<detail::portable_t<T>>(t);
+                Write(&value, sizeof(value));
+                return;
+            }
+        }
+        Write(std::addressof(t), sizeof(T));
+    }
+
+private:
+    /// closes the innermost payload with its length in front, encoded as
+    /// operator()(std::uint64_t) would
+    void WriteLengthPrefixed()
+    {
+        std::uint64_t size = m_payloads[m_payload_depth - 1].size;
+        std::byte header[detail::MaxVarintSize];
+        if (m_options.compact) {
+            ClosePayload({header, detail::EncodeVarint(size, header)});
+        } else {
+            std::memcpy(header, &size, sizeof(size));
+            ClosePayload({header, sizeof(size)});
+        }
+    }
+
+    /// strings of a string table archive start with the varint 2 * id + 1
+    /// of an earlier occurrence, or 2 * size followed by the characters of
+    /// the first one; empty strings are not worth an id
+    void WriteTableString(std::string_view str)
+    {
+        if (!str.empty()) {
+            auto &table = m_strings[m_string_depth];
+            if (auto it = table.find(str); it != table.end()) {
+                WriteVarint(2 * it->second + 1);
+                return;
+            }
+            table.emplace(str, table.size());
+        }
+        WriteVarint(2 * str.size());
+        Write(str.data(), str.size());
+    }
+
+    void WriteVarint(std::uint64_t value)
+    {
+        if constexpr (CountingSink<TSink>) {
+            Advance(detail::VarintSize(value));
+        } else {
+            std::byte buffer[detail::MaxVarintSize];
+            Write(buffer, detail::EncodeVarint(value, buffer));
+        }
+    }
+
+    void PushPayload(bool object)
+    {
+        if (m_payload_depth == m_payloads.size()) {
+            m_payloads.emplace_back();
+        }
+        auto &payload = m_payloads[m_payload_depth++];
+        payload.start = m_scratch_size;
+        payload.size = 0;
+        payload.object = object;
+        payload.fields.clear();
+        payload.unnamed = 0;
+    }
+
+    /// writes the innermost tagged object: its length, the number of fields,
+    /// their ids and lengths and finally the fields. Lengths and counts are
+    /// varints in every mode, small objects would otherwise be dominated by
+    /// their framing
+    void WriteObject()
+    {
+        constexpr auto max_varint = detail::MaxVarintSize;
+        const auto &payload = m_payloads[m_payload_depth - 1];
+        auto bound = 2 * max_varint +
+                     payload.fields.size() * (sizeof(std::uint32_t) +
+                                              max_varint);
+        if (m_directory.size() < bound) {
+            m_directory.resize(bound);
+        }
+        // the directory goes after room for the object length
+        auto *directory = m_directory.data() + max_varint;
+        auto *out = directory;
+        out += detail::EncodeVarint(payload.fields.size(), out);
+        for (auto [id, size] : payload.fields) {
+            std::memcpy(out, &id, sizeof(id));
+            out += sizeof(id);
+            out += detail::EncodeVarint(size, out);
+        }
+        std::byte length[max_varint];
+        auto n = detail::EncodeVarint((out - directory) + payload.size, length);
+        std::memcpy(directory - n, length, n);
+        ClosePayload({directory - n, out});
+    }
+
+    /// puts `header` in front of the innermost payload, which then becomes
+    /// part of its parent or is written out
+    void ClosePayload(std::span<const std::byte> header)
+    {
+        auto &payload = m_payloads[--m_payload_depth];
+        auto size = header.size() + payload.size;
+        if constexpr (!CountingSink<TSink>) {
+            ReserveScratch(header.size());
+            auto *start = m_scratch.data() + payload.start;
+            std::memmove(start + header.size(), start, payload.size);
+            std::memcpy(start, header.data(), header.size());
+            m_scratch_size += header.size();
+        }
+        if (m_payload_depth > 0) {
+            m_payloads[m_payload_depth - 1].size += size;
+            return;
+        }
+        if constexpr (CountingSink<TSink>) {
+            m_sink.Advance(size);
+        } else {
+            m_sink.Write(m_scratch.data(), m_scratch_size);
+            m_scratch_size = 0;
+        }
+        m_offset += size;
+    }
+
+    void ReserveScratch(std::size_t size)
+    {
+        if (m_scratch_size + size > m_scratch.size()) {
+            m_scratch.resize(std::max(
+                {m_scratch_size + size, 2 * m_scratch.size(), std::size_t{256}}));
+        }
+    }
+
+    void Write(const void *data, std::size_t size)
+    {
+        if (m_payload_depth > 0) [[unlikely]] {
+            if constexpr (!CountingSink<TSink>) {
+                ReserveScratch(size);
+                std::memcpy(m_scratch.data() + m_scratch_size, data, size);
+                m_scratch_size += size;
+            }
+            m_payloads[m_payload_depth - 1].size += size;
+            return;
+        }
+        m_sink.Write(data, size);
+        m_offset += size;
+    }
+
+    void Advance(std::size_t size)
+        requires CountingSink<TSink>
+    {
+        if (m_payload_depth > 0) [[unlikely]] {
+            m_payloads[m_payload_depth - 1].size += size;
+            return;
+        }
+        m_sink.Advance(size);
+        m_offset += size;
+    }
+
+    void WriteHeader()
+    {
+        Write(BinaryHeader::Magic.data(), BinaryHeader::Magic.size());
+        std::uint8_t version = BinaryHeader::Version;
+        std::uint8_t flags = m_options.Flags();
+        if (m_options.portable && BinaryOptions::NativeBigEndian) {
+            flags |= BinaryOptions::BigEndianFlag;
+        }
+        Write(&version, 1);
+        Write(&flags, 1);
+    }
+
+    template <typename T>
+    void WriteVarints(std::span<const T> items)
+    {
+        if constexpr (CountingSink<TSink>) {
+            std::size_t size = 0;
+            for (const auto &item : items) {
+                size += detail::VarintSize(detail::ZigZagEncode(item));
+            }
+            Advance(size);
+            return;
+        }
+        // encode in batches so the sink sees a few large writes
+        std::array<std::byte, 1024> buffer;
+        std::size_t n = 0;
+        for (const auto &item : items) {
+            if (n + detail::MaxVarintSize > buffer.size()) {
+                Write(buffer.data(), n);
+                n = 0;
+            }
+            n += detail::EncodeVarint(detail::ZigZagEncode(item),
+                                      buffer.data() + n);
+        }
+        Write(buffer.data(), n);
+    }
+
+    template <typename T>
+    void WritePortable(std::span<const T> items)
+    {
+        using W = detail::portable_t<T>;
+        if constexpr (CountingSink<TSink>) {
+            Advance(items.size() * sizeof(W));
+            return;
+        }
+        std::array<W, 256> buffer;
+        for (std::size_t i = 0; i < items.size(); i += buffer.size()) {
+            auto n = std::min(buffer.size(), items.size() - i);
+            for (std::size_t j = 0; j < n; ++j) {
+                buffer[j] = static_cast<W>(items[i + j]);
+            }
+            Write(buffer.data(), n * sizeof(W));
         }
     }
 };
 
-class BinaryDeserializer
+template <Source TSource>
+class BasicBinaryDeserializer
 {
-    std::istream &m_stream;
+    TSource m_source;
+    BinaryOptions m_options;
+    /// portable archive written with the other byte order
+    bool m_swap{false};
+    /// loaded on first use
+    std::optional<BinaryIndex> m_index;
+    /// tagged objects and Lazy payloads being read, reused like the
+    /// serializer's payloads
+    struct Frame {
+        bool object{false};
+        std::size_t begin{0};
+        std::size_t end{0};
+        /// id, offset and length of the fields of an object
+        std::vector<std::tuple<std::uint32_t, std::size_t, std::size_t>> fields;
+        std::size_t next{0};
+        std::uint32_t unnamed{0};
+    };
+    std::vector<Frame> m_frames;
+    std::size_t m_frame_depth{0};
+    std::vector<std::size_t> m_field_ends;
+    std::uint32_t m_unnamed{0};
+    /// start of the top-level values
+    std::size_t m_data_begin{0};
+    /// strings of a string table archive, the innermost Lazy payload's last;
+    /// borrowing sources keep them in place
+    using TableString = std::conditional_t<BorrowingSource<TSource>,
+                                           std::string_view, std::string>;
+    std::vector<std::vector<TableString>> m_strings;
+    std::size_t m_string_depth{0};
 
 public:
     static constexpr bool IsBinary() { return true; }
 
-    BinaryDeserializer(std::istream &stream) : m_stream(stream) {}
+    explicit BasicBinaryDeserializer(TSource source, BinaryOptions options = {})
+        : m_source(std::move(source)), m_options(options)
+    {
+        detail::CheckInOrderOptions(m_options);
+        Reset();
+    }
+
+    /// starts reading a new archive at the current position of the source,
+    /// e.g. the next message on a stream; internal buffers keep their
+    /// capacity
+    void Reset()
+    {
+        m_swap = false;
+        m_index.reset();
+        m_frame_depth = 0;
+        m_field_ends.clear();
+        m_unnamed = 0;
+        m_string_depth = 0;
+        if (m_options.string_table) {
+            if (m_strings.empty()) {
+                m_strings.resize(1);
+            }
+            m_strings.front().clear();
+        }
+        if (m_options != BinaryOptions{}) {
+            ReadHeader();
+        }
+        if (m_options.tagged) {
+            if constexpr (!SeekableSource<TSource>) {
+                ZEN_THROW("Tagged binary archives need a seekable source");
+            } else if constexpr (requires { m_source.Seekable(); }) {
+                ZEN_ENSURE_WITH_MSG(m_source.Seekable(),
+                                    "Tagged binary archives need a seekable "
+                                    "source");
+            }
+            if constexpr (SeekableSource<TSource>) {
+                m_data_begin = m_source.Position();
+            }
+        }
+    }
+
+    /// starts reading a new archive from `source`
+    void Rebind(TSource source)
+        requires std::is_nothrow_move_constructible_v<TSource>
+    {
+        std::destroy_at(&m_source);
+        std::construct_at(&m_source, std::move(source));
+        Reset();
+    }
+
+    TSource &GetSource() { return m_source; }
+
+    const BinaryOptions &Options() const { return m_options; }
+
+    bool SupportsBulkCopy() const
+    {
+        return !m_options.compact && !m_options.tagged && !m_swap;
+    }
+
+    /// table of contents of an indexed archive, read from its end on first
+    /// use without moving the read position
+    const BinaryIndex &Index()
+        requires SeekableSource<TSource>
+    {
+        if (m_index) {
+            return *m_index;
+        }
+        ZEN_ENSURE_WITH_MSG(m_options.indexed,
+                            "Binary archive was not written with "
+                            "BinaryOptions::indexed");
+        auto pos = m_source.Position();
+        auto size = m_source.Size();
+        std::array<std::byte, BinaryIndex::FooterSize> footer;
+        ZEN_ENSURE_WITH_MSG(size >= footer.size(),
+                            "Binary archive is truncated")
+        m_source.Seek(size - footer.size());
+        m_source.Read(footer.data(), footer.size());
+        auto offset = BinaryIndex::DecodeFooter(footer);
+        ZEN_ENSURE_WITH_MSG(offset <= size - footer.size(),
+                            fmt::format("Corrupted index offset {}", offset))
+        std::vector<std::byte> trailer(size - offset);
+        m_source.Seek(offset);
+        m_source.Read(trailer.data(), trailer.size());
+        m_index = BinaryIndex::Decode(trailer);
+        m_source.Seek(pos);
+        return *m_index;
+    }
+
+    bool IsTagged() const { return m_options.tagged; }
+
+    bool UsesTypeIds() const { return m_options.type_ids; }
+
+    void NewObject()
+    {
+        if constexpr (SeekableSource<TSource>) {
+            if (m_options.tagged) {
+                ReadObject();
+            }
+        }
+    }
+
+    void FinishObject()
+    {
+        if constexpr (SeekableSource<TSource>) {
+            if (m_options.tagged) {
+                SeekTo(m_frames[--m_frame_depth].end);
+            }
+        }
+    }
+
+    /**
+     * @brief Moves to the value of the NVP `name` in a tagged archive.
+     *
+     * Fields of objects are looked up in their directory, starting after the
+     * field read last. Top-level fields and those of Lazy payloads carry
+     * their id inline and are matched by skipping forward from the current
+     * position, wrapping around to the first one.
+     *
+     * @return false if the archive has no such field
+     */
+    bool BeginField(std::string_view name, std::uint32_t id)
+        requires SeekableSource<TSource>
+    {
+        Frame *frame = m_frame_depth > 0 ? &m_frames[m_frame_depth - 1]
+                                         : nullptr;
+        if (frame && frame->object) {
+            id = detail::ResolveFieldId(name, id, frame->unnamed);
+            auto &fields = frame->fields;
+            for (std::size_t k = 0; k < fields.size(); ++k) {
+                auto i = (frame->next + k) % fields.size();
+                auto [field_id, offset, size] = fields[i];
+                if (field_id == id) {
+                    SeekTo(offset);
+                    m_field_ends.push_back(offset + size);
+                    frame->next = i + 1;
+                    return true;
+                }
+            }
+            return false;
+        }
+        id = detail::ResolveFieldId(name, id, frame ? frame->unnamed
+                                                    : m_unnamed);
+        auto start = m_source.Position();
+        auto begin = frame ? frame->begin : m_data_begin;
+        auto end = frame ? frame->end : DataEnd();
+        if (FindInlineField(id, start, end) ||
+            FindInlineField(id, begin, start)) {
+            return true;
+        }
+        SeekTo(start);
+        return false;
+    }
+
+    /// moves past the field, skipping whatever the reader did not consume
+    void FinishField()
+        requires SeekableSource<TSource>
+    {
+        auto end = m_field_ends.back();
+        m_field_ends.pop_back();
+        ZEN_ENSURE_WITH_MSG(m_source.Position() <= end,
+                            "Reading a field went past its end, the reader's "
+                            "type does not match the archive");
+        SeekTo(end);
+    }
+
+    /// moves the read position to the value of the top-level entry `name`
+    void Seek(std::string_view name)
+        requires SeekableSource<TSource>
+    {
+        m_source.Seek(FindEntry(name, true).offset);
+    }
+
+    /**
+     * @brief Moves to the element `first` of the top-level range `name`, or
+     * as close before it as possible.
+     *
+     * @return the range size and the index of the element the read position
+     * is at: a chunk start of indexed ranges, `first` itself for fixed width
+     * arithmetic elements, 0 otherwise.
+     */
+    template <typename T>
+    std::pair<std::size_t, std::size_t> SeekRange(std::string_view name,
+                                                  std::size_t first)
+        requires SeekableSource<TSource>
+    {
+        const auto &entry = FindEntry(name, false);
+        m_source.Seek(entry.offset);
+        if (m_options.tagged) {
+            ReadFixed32();
+            std::uint64_t size;
+            (*this)(size);
+        }
+        std::uint64_t n;
+        (*this)(n);
+        first = std::min<std::uint64_t>(first, n);
+        if (!entry.chunks.empty()) {
+            auto chunk = std::min<std::size_t>(first / entry.stride,
+                                               entry.chunks.size() - 1);
+            ZEN_ENSURE_WITH_MSG(
+                !entry.chunk_dependent[chunk],
+                fmt::format("Chunk {} of {} references objects written before "
+                            "it and cannot be read on its own",
+                            chunk, name));
+            m_source.Seek(entry.chunks[chunk]);
+            return {n, chunk * entry.stride};
+        }
+        ZEN_ENSURE_WITH_MSG(!entry.dependent, DependentEntryMessage(name));
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (!(detail::is_varint_v<T> && m_options.compact)) {
+                auto width = m_options.portable ? sizeof(detail::portable_t<T>)
+                                                : sizeof(T);
+                m_source.Seek(m_source.Position() + first * width);
+                return {n, first};
+            }
+        }
+        return {n, 0};
+    }
+
+    /// reads the length of a Lazy payload and skips it if the source can
+    /// seek back to it later
+    detail::LazyPayload SkipPayload()
+    {
+        detail::LazyPayload payload;
+        (*this)(payload.size);
+        if constexpr (SeekableSource<TSource>) {
+            if constexpr (requires { m_source.Seekable(); }) {
+                if (!m_source.Seekable()) {
+                    return payload;
+                }
+            }
+            payload.deferred = true;
+            payload.offset = m_source.Position();
+            m_source.Seek(payload.offset + payload.size);
+        }
+        return payload;
+    }
+
+    /// moves to a skipped payload, returns the position to go back to
+    std::size_t ResumePayload(const detail::LazyPayload &payload)
+    {
+        if (m_options.string_table) {
+            if (++m_string_depth == m_strings.size()) {
+                m_strings.emplace_back();
+            }
+            m_strings[m_string_depth].clear();
+        }
+        if constexpr (SeekableSource<TSource>) {
+            if (payload.deferred) {
+                auto pos = m_source.Position();
+                m_source.Seek(payload.offset);
+                if (m_options.tagged) {
+                    auto &frame = PushFrame(false);
+                    frame.begin = payload.offset;
+                    frame.end = payload.offset + payload.size;
+                }
+                return pos;
+            }
+        }
+        return 0;
+    }
+
+    void LeavePayload(const detail::LazyPayload &payload, std::size_t pos)
+    {
+        if (m_options.string_table) {
+            --m_string_depth;
+        }
+        if constexpr (SeekableSource<TSource>) {
+            if (payload.deferred) {
+                if (m_options.tagged) {
+                    --m_frame_depth;
+                }
+                ZEN_ENSURE_WITH_MSG(
+                    m_source.Position() == payload.offset + payload.size,
+                    fmt::format("Lazy payload of {} bytes was not fully read",
+                                payload.size));
+                m_source.Seek(pos);
+            }
+        }
+    }
 
     void operator()(RangeSize &size) { (*this)(size.size); }
 
     void operator()(std::string &str)
     {
+        if (m_options.string_table) {
+            str = ReadTableString();
+            return;
+        }
         uint64_t size;
         (*this)(size);
         str.resize(size);
         (*this)(std::span<char>(str));
     }
 
-    void operator()(std::span<char> bytes)
+    template <typename T>
+        requires std::is_arithmetic_v<T> && (!std::is_const_v<T>)
+    void operator()(std::span<T> items)
     {
-        auto n = static_cast<std::streamsize>(bytes.size_bytes());
-        m_stream.read(bytes.data(), n);
-        if (!m_stream) {
-            ZEN_THROW(fmt::format("Failed to read {} bytes from stream", n));
+        if constexpr (detail::is_varint_v<T>) {
+            if (m_options.compact) {
+                ReadVarints(items);
+                return;
+            }
+        }
+        if (m_options.portable) {
+            ReadPortable(items);
+            return;
         }
+        m_source.Read(items.data(), items.size_bytes());
     }
 
     template <typename T>
         requires std::is_arithmetic_v<T>
     void operator()(T &t)
     {
-        auto ptr = reinterpret_cast<char *>(std::addressof(t));
-        auto n = static_cast<std::streamsize>(sizeof(T));
-        m_stream.read(ptr, n);
-        if (!m_stream) {
-            ZEN_THROW(fmt::format("Failed to read {} bytes from stream", n));
+        if constexpr (detail::is_varint_v<T>) {
+            if (m_options.compact) {
+                ReadVarints(std::span<T>(&t, 1));
+                return;
+            }
+        }
+        if (m_options.portable) {
+            ReadPortable(std::span<T>(&t, 1));
+            return;
+        }
+        m_source.Read(std::addressof(t), sizeof(T));
+    }
+
+    void operator()(std::string_view &str)
+        requires BorrowingSource<TSource>
+    {
+        if (m_options.string_table) {
+            str = ReadTableString();
+            return;
+        }
+        uint64_t size;
+        (*this)(size);
+        auto bytes = m_source.Borrow(size);
+        str = {reinterpret_cast<const char *>(bytes.data()), bytes.size()};
+    }
+
+    void operator()(BorrowedBlob &blob)
+        requires BorrowingSource<TSource>
+    {
+        uint64_t size;
+        (*this)(size);
+        blob.bytes = m_source.Borrow(size);
+    }
+
+    template <typename T>
+        requires std::is_arithmetic_v<T> && BorrowingSource<TSource>
+    void operator()(std::span<const T> &items)
+    {
+        if constexpr (detail::is_varint_v<T>) {
+            if (m_options.compact) {
+                ZEN_THROW("Cannot borrow varint encoded integers");
+            }
+        }
+        if (m_options.portable &&
+            (m_swap || !detail::is_portable_layout_v<T>)) {
+            ZEN_THROW(fmt::format("Cannot borrow {} from a portable archive of "
+                                  "different layout",
+                                  typeid(T).name()));
+        }
+        uint64_t size;
+        (*this)(size);
+        auto bytes = m_source.Borrow(size * sizeof(T));
+        if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(T) != 0) {
+            ZEN_THROW(fmt::format("Cannot borrow misaligned span of {}",
+                                  typeid(T).name()));
+        }
+        items = {reinterpret_cast<const T *>(bytes.data()), size};
+    }
+
+private:
+    const IndexEntry &FindEntry(std::string_view name, bool whole)
+        requires SeekableSource<TSource>
+    {
+        auto entry = Index().Find(name);
+        ZEN_ENSURE_WITH_MSG(entry != nullptr,
+                            fmt::format("No entry {} in the archive index",
+                                        name));
+        ZEN_ENSURE_WITH_MSG(!whole || !entry->dependent,
+                            DependentEntryMessage(name));
+        return *entry;
+    }
+
+    static std::string DependentEntryMessage(std::string_view name)
+    {
+        return fmt::format("Entry {} references objects of earlier entries "
+                           "and cannot be read on its own",
+                           name);
+    }
+
+    /// looks for field `id` among the inline fields starting in [pos, end)
+    bool FindInlineField(std::uint32_t id, std::size_t pos, std::size_t end)
+        requires SeekableSource<TSource>
+    {
+        while (pos + sizeof(id) <= end) {
+            SeekTo(pos);
+            auto field_id = ReadFixed32();
+            std::uint64_t size;
+            (*this)(size);
+            pos = m_source.Position();
+            if (field_id == id) {
+                m_field_ends.push_back(pos + size);
+                return true;
+            }
+            pos += size;
+        }
+        return false;
+    }
+
+    /// see BasicBinarySerializer::WriteTableString(), the view stays valid
+    /// until the next string is read, or as long as the buffer for
+    /// borrowing sources
+    std::string_view ReadTableString()
+    {
+        std::uint64_t tag;
+        ReadVarints(std::span(&tag, 1));
+        auto &table = m_strings[m_string_depth];
+        if (tag & 1) {
+            auto id = tag >> 1;
+            ZEN_ENSURE_WITH_MSG(id < table.size(),
+                                fmt::format("String id {} is not in the "
+                                            "string table of {} strings",
+                                            id, table.size()));
+            return table[id];
+        }
+        auto size = tag >> 1;
+        if (size == 0) {
+            return {};
+        }
+        if constexpr (BorrowingSource<TSource>) {
+            auto bytes = m_source.Borrow(size);
+            return table.emplace_back(
+                reinterpret_cast<const char *>(bytes.data()), bytes.size());
+        } else {
+            auto &str = table.emplace_back(size, '\0');
+            m_source.Read(str.data(), size);
+            return str;
+        }
+    }
+
+    Frame &PushFrame(bool object)
+    {
+        if (m_frame_depth == m_frames.size()) {
+            m_frames.emplace_back();
+        }
+        auto &frame = m_frames[m_frame_depth++];
+        frame.object = object;
+        frame.fields.clear();
+        frame.next = 0;
+        frame.unnamed = 0;
+        return frame;
+    }
+
+    /// reads the length and field directory of a tagged object
+    void ReadObject()
+        requires SeekableSource<TSource>
+    {
+        std::uint64_t length, count;
+        ReadVarints(std::span(&length, 1));
+        auto &frame = PushFrame(true);
+        frame.begin = m_source.Position();
+        frame.end = frame.begin + length;
+        ReadVarints(std::span(&count, 1));
+        ZEN_ENSURE_WITH_MSG(count <= length,
+                            fmt::format("Corrupted tagged object of {} bytes "
+                                        "with {} fields",
+                                        length, count));
+        frame.fields.resize(count);
+        for (auto &[id, offset, size] : frame.fields) {
+            id = ReadFixed32();
+            std::uint64_t n;
+            ReadVarints(std::span(&n, 1));
+            size = n;
+        }
+        auto offset = m_source.Position();
+        for (auto &field : frame.fields) {
+            std::get<1>(field) = offset;
+            offset += std::get<2>(field);
+        }
+        ZEN_ENSURE_WITH_MSG(offset <= frame.end,
+                            "Tagged object fields exceed the object");
+    }
+
+    /// field ids are written with a fixed width in the writer's byte order
+    std::uint32_t ReadFixed32()
+    {
+        std::uint32_t value;
+        m_source.Read(&value, sizeof(value));
+        if (m_swap) {
+            detail::ByteSwapInPlace(&value, 1, sizeof(value));
+        }
+        return value;
+    }
+
+    void SeekTo(std::size_t pos)
+        requires SeekableSource<TSource>
+    {
+        if (m_source.Position() != pos) {
+            m_source.Seek(pos);
+        }
+    }
+
+    /// end of the top-level values: the archive end or the index start
+    std::size_t DataEnd()
+        requires SeekableSource<TSource>
+    {
+        auto size = m_source.Size();
+        if (!m_options.indexed || size < BinaryIndex::FooterSize) {
+            return size;
+        }
+        auto pos = m_source.Position();
+        std::array<std::byte, BinaryIndex::FooterSize> footer;
+        m_source.Seek(size - footer.size());
+        m_source.Read(footer.data(), footer.size());
+        m_source.Seek(pos);
+        return std::min<std::size_t>(BinaryIndex::DecodeFooter(footer), size);
+    }
+
+    void ReadHeader()
+    {
+        std::array<char, 4> magic;
+        std::uint8_t version, flags;
+        m_source.Read(magic.data(), magic.size());
+        m_source.Read(&version, 1);
+        m_source.Read(&flags, 1);
+        ZEN_ENSURE_WITH_MSG(magic == BinaryHeader::Magic,
+                            "Not a zen binary archive header")
+        ZEN_ENSURE_WITH_MSG(version <= BinaryHeader::Version,
+                            fmt::format("Unsupported binary version {}",
+                                        version))
+        ZEN_ENSURE_WITH_MSG(BinaryOptions::FromFlags(flags) == m_options,
+                            fmt::format("Archive flags {:#x} do not match the "
+                                        "reader options {:#x}",
+                                        flags, m_options.Flags()))
+        bool big_endian = (flags & BinaryOptions::BigEndianFlag) != 0;
+        m_swap =
+            m_options.portable && big_endian != BinaryOptions::NativeBigEndian;
+    }
+
+    template <typename T>
+    void ReadPortable(std::span<T> items)
+    {
+        using W = detail::portable_t<T>;
+        if constexpr (detail::is_portable_layout_v<T>) {
+            if (!m_swap) {
+                m_source.Read(items.data(), items.size_bytes());
+            } else if constexpr (BorrowingSource<TSource>) {
+                // swap straight out of the buffer in a single pass
+                auto bytes = m_source.Borrow(items.size_bytes());
+                detail::ByteSwapCopy(items.data(), bytes.data(), items.size(),
+                                     sizeof(T));
+            } else {
+                m_source.Read(items.data(), items.size_bytes());
+                detail::ByteSwapInPlace(items.data(), items.size(), sizeof(T));
+            }
+        } else {
+            std::array<W, 256> buffer;
+            for (std::size_t i = 0; i < items.size(); i += buffer.size()) {
+                auto n = std::min(buffer.size(), items.size() - i);
+                m_source.Read(buffer.data(), n * sizeof(W));
+                if (m_swap) {
+                    detail::ByteSwapInPlace(buffer.data(), n, sizeof(W));
+                }
+                for (std::size_t j = 0; j < n; ++j) {
+                    items[i + j] = detail::FromPortable<T>(buffer[j]);
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void ReadVarints(std::span<T> items)
+    {
+        if constexpr (BorrowingSource<TSource>) {
+            auto in = m_source.Remaining();
+            m_source.Borrow(detail::DecodeVarints(in, items));
+        } else {
+            for (auto &item : items) {
+                std::byte buffer[detail::MaxVarintSize];
+                std::size_t n = 0;
+                do {
+                    if (n == detail::MaxVarintSize) {
+                        ZEN_THROW("Malformed varint");
+                    }
+                    m_source.Read(&buffer[n], 1);
+                } while (std::to_integer<int>(buffer[n++]) & 0x80);
+                std::uint64_t value;
+                detail::DecodeVarint({buffer, n}, value);
+                item = detail::ZigZagDecode<T>(value);
+            }
         }
     }
 };
-} // namespace zen
\ No newline at end of file
+
+using BinarySerializer = BasicBinarySerializer<StreamSink>;
+using BufferBinarySerializer = BasicBinarySerializer<BufferSink>;
+using SpanBinarySerializer = BasicBinarySerializer<SpanSink>;
+using MappedBinarySerializer = BasicBinarySerializer<MappedFileSink>;
+using SizeSerializer = BasicBinarySerializer<SizeSink>;
+
+using BinaryDeserializer = BasicBinaryDeserializer<StreamSource>;
+using BufferBinaryDeserializer = BasicBinaryDeserializer<SpanSource>;
+} // namespace zen
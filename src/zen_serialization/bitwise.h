@@ -0,0 +1,157 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file bitwise.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 19:26:55, October 18, 2025
+ */
+#pragma once
+#include "archive_base.h"
+#include "byteswap.h"
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <type_traits>
+
+namespace zen
+{
+
+/**
+ * @brief Opt-in trait for element types whose binary encoding is their object
+ * representation, e.g.
+ *
+ *   template <>
+ *   struct zen::is_bitwise_serializable<Vec3> : std::true_type {};
+ *
+ * Contiguous ranges of such types are written and read with a single memcpy.
+ * Members should be fixed-width types for archives in portable mode.
+ * Without the specialization the layout is probed automatically, see
+ * IsBitwiseSerializable.
+ */
+template <typename T>
+struct is_bitwise_serializable : std::false_type {};
+
+namespace detail
+{
+template <typename T>
+struct is_std_array : std::false_type {};
+
+template <typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+template <typename T>
+struct is_std_complex : std::false_type {};
+
+template <typename T>
+struct is_std_complex<std::complex<T>> : std::true_type {};
+
+/**
+ * @brief Archive that walks the serialize functions of a sample object and
+ * checks that the serialized scalars tile its memory exactly: in declaration
+ * order, without gaps (padding) and without anything stored outside of it.
+ * Only then is the element-wise binary encoding identical to the raw bytes.
+ * Scalars whose portable wire width differs from their size on this host
+ * (e.g. long on Windows) are rejected as well.
+ */
+class LayoutProbe
+{
+    const std::byte *m_base;
+    std::size_t m_offset{0};
+    bool m_ok{true};
+
+    explicit LayoutProbe(const std::byte *base) : m_base(base) {}
+
+public:
+    static constexpr bool IsInput() { return false; }
+
+    template <typename T>
+    static bool Verify(const T &item)
+    {
+        LayoutProbe probe(reinterpret_cast<const std::byte *>(&item));
+        probe.visit(item);
+        return probe.m_ok && probe.m_offset == sizeof(T);
+    }
+
+    void operator()(auto &&...items) { (visit(make_nvp(items)), ...); }
+
+private:
+    void leaf(const void *ptr, std::size_t size)
+    {
+        auto offset = static_cast<const std::byte *>(ptr) - m_base;
+        if (offset != static_cast<std::ptrdiff_t>(m_offset)) {
+            m_ok = false;
+        }
+        m_offset += size;
+    }
+
+    template <typename T>
+    void visit(const NamedValuePair<T> &item)
+    {
+        visit(item.value);
+    }
+
+    template <typename T>
+    void visit(const BaseClass<T> &item)
+    {
+        visit(*item.ptr);
+    }
+
+    template <typename T>
+    void visit(const T &item)
+    {
+        if (!m_ok) {
+            return;
+        }
+        if constexpr (std::is_arithmetic_v<T>) {
+            if constexpr (is_portable_layout_v<T>) {
+                leaf(&item, sizeof(T));
+            } else {
+                m_ok = false;
+            }
+        } else if constexpr (std::is_enum_v<T>) {
+            if constexpr (is_portable_layout_v<std::underlying_type_t<T>>) {
+                leaf(&item, sizeof(T));
+            } else {
+                m_ok = false;
+            }
+        } else if constexpr (is_std_complex<T>::value) {
+            if constexpr (is_portable_layout_v<typename T::value_type>) {
+                leaf(&item, sizeof(T));
+            } else {
+                m_ok = false;
+            }
+        } else if constexpr (is_std_array<T>::value) {
+            for (const auto &i : item) {
+                visit(i);
+            }
+        } else if constexpr (requires(T t) { t.serialize(*this); }) {
+            const_cast<T &>(item).serialize(*this);
+        } else if constexpr (requires(T t) { serialize(t, *this); }) {
+            serialize(const_cast<T &>(item), *this);
+        } else {
+            m_ok = false;
+        }
+    }
+};
+} // namespace detail
+
+/// Whether elements of type T can be bulk copied. The layout is probed once
+/// per type on `sample`; types specializing is_bitwise_serializable skip it.
+template <typename T>
+bool IsBitwiseSerializable(const T &sample)
+{
+    if constexpr (is_bitwise_serializable<T>::value) {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "bitwise serializable types must be trivially copyable");
+        return true;
+    } else if constexpr (!std::is_trivially_copyable_v<T>) {
+        return false;
+    } else {
+        static const bool result = detail::LayoutProbe::Verify(sample);
+        return result;
+    }
+}
+
+} // namespace zen
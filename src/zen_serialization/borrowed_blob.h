@@ -0,0 +1,21 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file borrowed_blob.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 21:03:47, October 17, 2025
+ */
+#pragma once
+#include <cstddef>
+#include <span>
+
+namespace zen
+{
+/// Opaque byte payload. On save the bytes are written as a length-prefixed
+/// block, on load from a buffer-backed binary archive `bytes` points straight
+/// into the archive buffer. The binary encoding matches std::vector<std::byte>.
+struct BorrowedBlob {
+    std::span<const std::byte> bytes;
+};
+} // namespace zen
@@ -0,0 +1,110 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file byteswap.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 10:17:35, October 19, 2025
+ */
+#pragma once
+#include "archive_base.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace zen::detail
+{
+
+/// Copies `count` elements of `width` bytes each from `src` to `dst`,
+/// reversing the byte order of every element. Uses AVX2 or SSSE3 shuffles
+/// when the CPU supports them and a scalar loop otherwise. `dst` and `src`
+/// may be the same but must not otherwise overlap.
+ZEN_SERIALIZATION_EXPORT void ByteSwapCopy(void *dst, const void *src,
+                                           std::size_t count,
+                                           std::size_t width);
+
+ZEN_SERIALIZATION_EXPORT void ByteSwapInPlace(void *data, std::size_t count,
+                                              std::size_t width);
+
+/// scalar reference implementations, also used for the SIMD tails
+ZEN_SERIALIZATION_EXPORT void ByteSwapCopyScalar(void *dst, const void *src,
+                                                 std::size_t count,
+                                                 std::size_t width);
+
+ZEN_SERIALIZATION_EXPORT void ByteSwapInPlaceScalar(void *data,
+                                                    std::size_t count,
+                                                    std::size_t width);
+
+template <typename T>
+    requires std::is_arithmetic_v<T>
+T ByteSwap(T value)
+{
+    if constexpr (sizeof(T) == 1) {
+        return value;
+    } else if constexpr (std::is_integral_v<T>) {
+        return std::byteswap(value);
+    } else {
+        using U = std::conditional_t<
+            sizeof(T) == 2, std::uint16_t,
+            std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>;
+        return std::bit_cast<T>(std::byteswap(std::bit_cast<U>(value)));
+    }
+}
+
+/**
+ * @brief Wire type of T in the portable binary format.
+ *
+ * Types whose width differs between platforms are stored with a fixed width:
+ * long and unsigned long as 64 bit, wchar_t as 32 bit and long double as
+ * double.
+ */
+template <typename T>
+struct portable_type {
+    using type = T;
+};
+
+template <>
+struct portable_type<long> {
+    using type = std::int64_t;
+};
+
+template <>
+struct portable_type<unsigned long> {
+    using type = std::uint64_t;
+};
+
+template <>
+struct portable_type<wchar_t> {
+    using type = std::uint32_t;
+};
+
+template <>
+struct portable_type<long double> {
+    using type = double;
+};
+
+template <typename T>
+using portable_t = typename portable_type<T>::type;
+
+/// whether the in-memory representation of T on this host is already its
+/// portable wire representation, up to byte order
+template <typename T>
+constexpr bool is_portable_layout_v = sizeof(portable_t<T>) == sizeof(T);
+
+/// converts a portable wire value back to T, throwing if it does not fit
+template <typename T, typename W>
+T FromPortable(W value)
+{
+    auto result = static_cast<T>(value);
+    if constexpr (std::is_integral_v<T>) {
+        if (static_cast<W>(result) != value) {
+            ZEN_THROW(fmt::format("Value {} does not fit into {}", value,
+                                  typeid(T).name()));
+        }
+    }
+    return result;
+}
+
+} // namespace zen::detail
@@ -0,0 +1,330 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file checksum.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 11:02:37, October 21, 2025
+ */
+#pragma once
+#include "binary_serializer.h"
+#include "crc32c.h"
+#include "sink.h"
+#include "source.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace zen
+{
+
+enum class ChecksumVerify : std::uint8_t {
+    /// a chunk is verified completely before any of its bytes are handed
+    /// out, so a corrupted archive never produces values
+    Eager,
+    /// bytes are handed out while they are read and the checksum is checked
+    /// once the chunk is consumed, saving the staging copy of stream reads;
+    /// corruption is reported at most one chunk late
+    Lazy,
+    /// the framing is skipped without computing checksums
+    Off,
+};
+
+struct ChecksumOptions {
+    /// payload bytes per chunk
+    std::size_t chunk_size{64 << 10};
+    ChecksumVerify verify{ChecksumVerify::Eager};
+};
+
+namespace detail
+{
+
+/**
+ * Checksummed stream layout, all integers little endian:
+ *
+ *   stream : 'Z' 'E' 'N' 'K' version:u8 chunk_size:u32 chunk*
+ *   chunk  : size:u32 crc32c:u32 payload[size]
+ *
+ * The checksum covers the payload only; a corrupted size is caught by the
+ * chunk_size limit, a mismatch of the following chunk or a short read.
+ */
+struct ChecksumStreamHeader {
+    static constexpr std::array<char, 4> Magic{'Z', 'E', 'N', 'K'};
+    static constexpr std::uint8_t Version = 1;
+    static constexpr std::size_t Size = Magic.size() + 1 + 4;
+};
+
+constexpr std::size_t ChunkHeaderSize = 8;
+
+inline void StoreChunkHeader(std::byte *out, std::uint32_t size,
+                             std::uint32_t crc)
+{
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<std::byte>(size >> (8 * i));
+        out[4 + i] = static_cast<std::byte>(crc >> (8 * i));
+    }
+}
+
+inline std::pair<std::uint32_t, std::uint32_t>
+LoadChunkHeader(const std::byte *in)
+{
+    std::uint32_t size = 0, crc = 0;
+    for (int i = 0; i < 4; ++i) {
+        size |= std::to_integer<std::uint32_t>(in[i]) << (8 * i);
+        crc |= std::to_integer<std::uint32_t>(in[4 + i]) << (8 * i);
+    }
+    return {size, crc};
+}
+
+} // namespace detail
+
+/**
+ * @brief Sink splitting the stream into chunks carrying a CRC-32C.
+ *
+ * Small writes are collected into a chunk buffer; writes of at least a whole
+ * chunk are checksummed and passed on directly without copying. Flush()
+ * closes the current chunk early.
+ */
+template <Sink TSink>
+class ChecksumSink
+{
+    TSink m_sink;
+    ChecksumOptions m_options;
+    std::vector<std::byte> m_chunk;
+    std::size_t m_size{0};
+
+public:
+    explicit ChecksumSink(TSink sink, ChecksumOptions options = {})
+        : m_sink(std::move(sink)), m_options(options),
+          m_chunk(detail::ChunkHeaderSize + options.chunk_size)
+    {
+        constexpr auto MaxChunkSize = std::numeric_limits<std::uint32_t>::max();
+        ZEN_ENSURE_WITH_MSG(m_options.chunk_size > 0 &&
+                                m_options.chunk_size <= MaxChunkSize,
+                            fmt::format("Invalid checksum chunk size {}",
+                                        m_options.chunk_size));
+        using Header = detail::ChecksumStreamHeader;
+        std::array<std::byte, Header::Size> header;
+        for (std::size_t i = 0; i < Header::Magic.size(); ++i) {
+            header[i] = static_cast<std::byte>(Header::Magic[i]);
+        }
+        header[4] = std::byte{Header::Version};
+        auto chunk_size = static_cast<std::uint32_t>(m_options.chunk_size);
+        for (int i = 0; i < 4; ++i) {
+            header[5 + i] = static_cast<std::byte>(chunk_size >> (8 * i));
+        }
+        m_sink.Write(header.data(), header.size());
+    }
+
+    ChecksumSink(ChecksumSink &&other) noexcept
+        : m_sink(std::move(other.m_sink)), m_options(other.m_options),
+          m_chunk(std::move(other.m_chunk)),
+          m_size(std::exchange(other.m_size, 0))
+    {
+    }
+
+    ChecksumSink(const ChecksumSink &) = delete;
+    ChecksumSink &operator=(const ChecksumSink &) = delete;
+
+    ~ChecksumSink()
+    {
+        try {
+            WriteChunk();
+        } catch (...) {
+        }
+    }
+
+    TSink &GetSink() { return m_sink; }
+
+    void Write(const void *data, std::size_t size)
+    {
+        auto bytes = static_cast<const std::byte *>(data);
+        auto chunk_size = m_options.chunk_size;
+        while (size > 0) {
+            if (m_size == 0 && size >= chunk_size) {
+                std::array<std::byte, detail::ChunkHeaderSize> header;
+                detail::StoreChunkHeader(
+                    header.data(), static_cast<std::uint32_t>(chunk_size),
+                    detail::Crc32c(bytes, chunk_size));
+                m_sink.Write(header.data(), header.size());
+                m_sink.Write(bytes, chunk_size);
+                bytes += chunk_size;
+                size -= chunk_size;
+                continue;
+            }
+            auto n = std::min(size, chunk_size - m_size);
+            std::memcpy(m_chunk.data() + detail::ChunkHeaderSize + m_size,
+                        bytes, n);
+            m_size += n;
+            bytes += n;
+            size -= n;
+            if (m_size == chunk_size) {
+                WriteChunk();
+            }
+        }
+    }
+
+    void Flush()
+    {
+        WriteChunk();
+        if constexpr (requires { m_sink.Flush(); }) {
+            m_sink.Flush();
+        }
+    }
+
+private:
+    void WriteChunk()
+    {
+        if (m_size == 0) {
+            return;
+        }
+        auto payload = m_chunk.data() + detail::ChunkHeaderSize;
+        detail::StoreChunkHeader(m_chunk.data(),
+                                 static_cast<std::uint32_t>(m_size),
+                                 detail::Crc32c(payload, m_size));
+        m_sink.Write(m_chunk.data(), detail::ChunkHeaderSize + m_size);
+        m_size = 0;
+    }
+};
+
+/**
+ * @brief Source verifying and stripping the chunks written by ChecksumSink.
+ *
+ * Only `verify` of the options is used, the chunk size is read from the
+ * stream. Over a borrowing source (e.g. SpanSource) every chunk is verified
+ * in place when it is entered, whatever the mode except Off. A mismatch
+ * throws naming the chunk and the offset it ends at.
+ */
+template <Source TSource>
+class ChecksumSource
+{
+    TSource m_source;
+    ChecksumOptions m_options;
+    /// current chunk, when it is staged or borrowed
+    std::span<const std::byte> m_chunk;
+    std::vector<std::byte> m_buffer;
+    std::size_t m_pos{0};
+    /// bytes of the current chunk not read yet
+    std::size_t m_remaining{0};
+    std::uint32_t m_expected{0};
+    /// running checksum of the current chunk in Lazy mode
+    std::uint32_t m_crc{0};
+    /// the current chunk is streamed and checked once consumed
+    bool m_lazy{false};
+    std::size_t m_chunk_size{0};
+    std::size_t m_index{0};
+    std::size_t m_offset{detail::ChecksumStreamHeader::Size};
+
+public:
+    explicit ChecksumSource(TSource source, ChecksumOptions options = {})
+        : m_source(std::move(source)), m_options(options)
+    {
+        using Header = detail::ChecksumStreamHeader;
+        std::array<std::byte, Header::Size> header;
+        m_source.Read(header.data(), header.size());
+        for (std::size_t i = 0; i < Header::Magic.size(); ++i) {
+            ZEN_ENSURE_WITH_MSG(
+                header[i] == static_cast<std::byte>(Header::Magic[i]),
+                "Not a checksummed archive");
+        }
+        auto version = std::to_integer<std::uint8_t>(header[4]);
+        ZEN_ENSURE_WITH_MSG(
+            version == Header::Version,
+            fmt::format("Unsupported checksummed stream version {}", version));
+        m_chunk_size = 0;
+        for (int i = 0; i < 4; ++i) {
+            m_chunk_size |= std::to_integer<std::size_t>(header[5 + i])
+                            << (8 * i);
+        }
+    }
+
+    TSource &GetSource() { return m_source; }
+
+    void Read(void *data, std::size_t size)
+    {
+        auto out = static_cast<std::byte *>(data);
+        while (size > 0) {
+            if (m_remaining == 0) {
+                NextChunk();
+            }
+            auto n = std::min(size, m_remaining);
+            if (!m_chunk.empty()) {
+                std::memcpy(out, m_chunk.data() + m_pos, n);
+                m_pos += n;
+            } else {
+                m_source.Read(out, n);
+                if (m_lazy) {
+                    m_crc = detail::Crc32c(out, n, m_crc);
+                }
+            }
+            m_remaining -= n;
+            out += n;
+            size -= n;
+            if (m_remaining == 0 && m_lazy) {
+                Check(m_crc);
+            }
+        }
+    }
+
+private:
+    void NextChunk()
+    {
+        // an empty chunk is never written, but skipping it is harmless
+        do {
+            std::array<std::byte, detail::ChunkHeaderSize> header;
+            m_source.Read(header.data(), header.size());
+            std::tie(m_remaining, m_expected) =
+                detail::LoadChunkHeader(header.data());
+            m_offset += detail::ChunkHeaderSize;
+            m_index++;
+        } while (m_remaining == 0);
+        if (m_remaining > m_chunk_size) {
+            ZEN_THROW(fmt::format("Corrupted chunk {} at offset {}: size {} "
+                                  "exceeds the chunk size {}",
+                                  m_index - 1, m_offset, m_remaining,
+                                  m_chunk_size));
+        }
+        m_crc = 0;
+        m_pos = 0;
+        m_chunk = {};
+        m_lazy = false;
+        if constexpr (BorrowingSource<TSource>) {
+            m_chunk = m_source.Borrow(m_remaining);
+        } else if (m_options.verify == ChecksumVerify::Eager) {
+            m_buffer.resize(m_remaining);
+            m_source.Read(m_buffer.data(), m_remaining);
+            m_chunk = m_buffer;
+        } else {
+            m_lazy = m_options.verify == ChecksumVerify::Lazy;
+        }
+        if (!m_chunk.empty() && m_options.verify != ChecksumVerify::Off) {
+            Check(detail::Crc32c(m_chunk.data(), m_chunk.size()));
+        }
+        m_offset += m_remaining;
+    }
+
+    void Check(std::uint32_t crc) const
+    {
+        if (crc != m_expected) {
+            ZEN_THROW(fmt::format(
+                "Checksum mismatch in chunk {} ending at offset {}: expect "
+                "{:08x}, got {:08x}",
+                m_index - 1, m_offset, m_expected, crc));
+        }
+    }
+};
+
+using ChecksummedBinarySerializer =
+    BasicBinarySerializer<ChecksumSink<StreamSink>>;
+using BufferChecksummedBinarySerializer =
+    BasicBinarySerializer<ChecksumSink<BufferSink>>;
+using ChecksummedBinaryDeserializer =
+    BasicBinaryDeserializer<ChecksumSource<StreamSource>>;
+using BufferChecksummedBinaryDeserializer =
+    BasicBinaryDeserializer<ChecksumSource<SpanSource>>;
+
+} // namespace zen
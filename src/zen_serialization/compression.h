@@ -0,0 +1,363 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file compression.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 14:32:56, October 20, 2025
+ */
+#pragma once
+#include "binary_serializer.h"
+#include "sink.h"
+#include "source.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace zen
+{
+
+enum class Codec : std::uint8_t {
+    /// frames are stored as is
+    None = 0,
+    /// every frame is a self contained zstd frame, only available when the
+    /// library is built with ZEN_SERIALIZATION_WITH_ZSTD
+    Zstd = 1,
+};
+
+struct CompressionOptions {
+#ifdef ZEN_SERIALIZATION_WITH_ZSTD
+    Codec codec{Codec::Zstd};
+#else
+    Codec codec{Codec::None};
+#endif
+    /// codec specific compression level
+    int level{3};
+    /// uncompressed bytes per frame
+    std::size_t block_size{1 << 20};
+    /// frames being compressed or decompressed ahead at most, which bounds
+    /// the memory to about 2 * max_in_flight * block_size;
+    /// 0 uses twice the number of pool threads
+    std::size_t max_in_flight{0};
+    /// pool running the codec, ThreadPool::Default() if null
+    ThreadPool *pool{nullptr};
+
+    ThreadPool &Pool() const
+    {
+        return pool ? *pool : ThreadPool::Default();
+    }
+
+    std::size_t MaxInFlight() const
+    {
+        return max_in_flight ? max_in_flight
+                             : std::max<std::size_t>(2, 2 * Pool().Size());
+    }
+};
+
+namespace detail
+{
+
+/**
+ * Compressed stream layout, all integers little endian:
+ *
+ *   stream : 'Z' 'E' 'N' 'C' version:u8 codec:u8 frame*
+ *   frame  : stored_size:u32 raw_size:u32 payload[stored_size]
+ *
+ * Every payload decodes on its own to raw_size bytes. A frame with both sizes
+ * 0 marks the end of a flushed segment, readers only prefetch up to it.
+ */
+struct CompressedStreamHeader {
+    static constexpr std::array<char, 4> Magic{'Z', 'E', 'N', 'C'};
+    static constexpr std::uint8_t Version = 1;
+    static constexpr std::size_t Size = Magic.size() + 2;
+};
+
+constexpr std::size_t FrameHeaderSize = 8;
+
+inline void StoreFrameHeader(std::byte *out, std::uint32_t stored,
+                             std::uint32_t raw)
+{
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<std::byte>(stored >> (8 * i));
+        out[4 + i] = static_cast<std::byte>(raw >> (8 * i));
+    }
+}
+
+inline std::pair<std::uint32_t, std::uint32_t>
+LoadFrameHeader(const std::byte *in)
+{
+    std::uint32_t stored = 0, raw = 0;
+    for (int i = 0; i < 4; ++i) {
+        stored |= std::to_integer<std::uint32_t>(in[i]) << (8 * i);
+        raw |= std::to_integer<std::uint32_t>(in[4 + i]) << (8 * i);
+    }
+    return {stored, raw};
+}
+
+ZEN_SERIALIZATION_EXPORT bool HasCodec(Codec codec);
+
+/// compresses `raw` into a complete frame, header included
+ZEN_SERIALIZATION_EXPORT std::vector<std::byte>
+EncodeFrame(Codec codec, int level, std::span<const std::byte> raw);
+
+/// decodes a frame payload that must expand to exactly `raw_size` bytes
+ZEN_SERIALIZATION_EXPORT std::vector<std::byte>
+DecodeFrame(Codec codec, std::span<const std::byte> payload,
+            std::size_t raw_size);
+
+inline void EnsureCodec(Codec codec)
+{
+    ZEN_ENSURE_WITH_MSG(HasCodec(codec),
+                        fmt::format("Compression codec {} is not available",
+                                    static_cast<int>(codec)));
+}
+
+} // namespace detail
+
+/**
+ * @brief Sink compressing everything written to it in independent frames.
+ *
+ * Bytes are collected into blocks of `block_size`; full blocks are handed to
+ * the thread pool and the serializer continues right away. Finished frames
+ * are written to the downstream sink in order on the calling thread, which
+ * waits only when `max_in_flight` blocks are pending. Flush() drains all
+ * frames and ends the segment, so a reader can consume everything written so
+ * far.
+ */
+template <Sink TSink>
+class CompressingSink
+{
+    TSink m_sink;
+    CompressionOptions m_options;
+    std::vector<std::byte> m_block;
+    std::deque<std::future<std::vector<std::byte>>> m_pending;
+    /// frames were written since the last segment end
+    bool m_open_segment{false};
+    /// false once moved from
+    bool m_active{true};
+
+public:
+    explicit CompressingSink(TSink sink, CompressionOptions options = {})
+        : m_sink(std::move(sink)), m_options(options)
+    {
+        detail::EnsureCodec(m_options.codec);
+        constexpr auto MaxBlockSize = std::numeric_limits<std::uint32_t>::max();
+        ZEN_ENSURE_WITH_MSG(m_options.block_size > 0 &&
+                                m_options.block_size <= MaxBlockSize / 2,
+                            fmt::format("Invalid compression block size {}",
+                                        m_options.block_size));
+        using Header = detail::CompressedStreamHeader;
+        std::array<std::byte, Header::Size> header;
+        for (std::size_t i = 0; i < Header::Magic.size(); ++i) {
+            header[i] = static_cast<std::byte>(Header::Magic[i]);
+        }
+        header[4] = std::byte{Header::Version};
+        header[5] = static_cast<std::byte>(m_options.codec);
+        m_sink.Write(header.data(), header.size());
+        m_block.reserve(m_options.block_size);
+    }
+
+    CompressingSink(CompressingSink &&other) noexcept
+        : m_sink(std::move(other.m_sink)), m_options(other.m_options),
+          m_block(std::move(other.m_block)),
+          m_pending(std::move(other.m_pending)),
+          m_open_segment(other.m_open_segment),
+          m_active(std::exchange(other.m_active, false))
+    {
+    }
+
+    CompressingSink(const CompressingSink &) = delete;
+    CompressingSink &operator=(const CompressingSink &) = delete;
+
+    ~CompressingSink()
+    {
+        if (m_active) {
+            try {
+                Finish();
+            } catch (...) {
+            }
+        }
+    }
+
+    TSink &GetSink() { return m_sink; }
+
+    const CompressionOptions &Options() const { return m_options; }
+
+    void Write(const void *data, std::size_t size)
+    {
+        auto bytes = static_cast<const std::byte *>(data);
+        while (size > 0) {
+            auto n = std::min(size, m_options.block_size - m_block.size());
+            m_block.insert(m_block.end(), bytes, bytes + n);
+            bytes += n;
+            size -= n;
+            if (m_block.size() == m_options.block_size) {
+                SubmitBlock();
+            }
+        }
+    }
+
+    void Flush()
+    {
+        Finish();
+        if constexpr (requires { m_sink.Flush(); }) {
+            m_sink.Flush();
+        }
+    }
+
+private:
+    void Finish()
+    {
+        if (!m_block.empty()) {
+            SubmitBlock();
+        }
+        while (!m_pending.empty()) {
+            WriteFrame();
+        }
+        if (m_open_segment) {
+            std::array<std::byte, detail::FrameHeaderSize> end;
+            detail::StoreFrameHeader(end.data(), 0, 0);
+            m_sink.Write(end.data(), end.size());
+            m_open_segment = false;
+        }
+    }
+
+    void SubmitBlock()
+    {
+        auto block = std::exchange(m_block, {});
+        m_block.reserve(m_options.block_size);
+        m_pending.push_back(m_options.Pool().Submit(
+            [codec = m_options.codec, level = m_options.level,
+             block = std::move(block)] {
+                return detail::EncodeFrame(codec, level, block);
+            }));
+        m_open_segment = true;
+        // pass on frames as soon as they are done, but keep the order
+        while (!m_pending.empty() &&
+               (m_pending.size() > m_options.MaxInFlight() ||
+                m_pending.front().wait_for(std::chrono::seconds(0)) ==
+                    std::future_status::ready)) {
+            WriteFrame();
+        }
+    }
+
+    void WriteFrame()
+    {
+        auto frame = m_pending.front().get();
+        m_pending.pop_front();
+        m_sink.Write(frame.data(), frame.size());
+    }
+};
+
+/**
+ * @brief Source decompressing a stream written by CompressingSink.
+ *
+ * Frames are read from the upstream source on the calling thread and decoded
+ * on the thread pool, up to `max_in_flight` ahead of the deserializer and
+ * never past the end of the current segment. Only the codec, pool and
+ * max_in_flight of `options` are used, the codec must match the stream's.
+ */
+template <Source TSource>
+class DecompressingSource
+{
+    TSource m_source;
+    CompressionOptions m_options;
+    std::deque<std::future<std::vector<std::byte>>> m_pending;
+    std::vector<std::byte> m_block;
+    std::size_t m_pos{0};
+    /// the prefetch stopped at a segment end
+    bool m_segment_end{false};
+
+public:
+    explicit DecompressingSource(TSource source,
+                                 CompressionOptions options = {})
+        : m_source(std::move(source)), m_options(options)
+    {
+        using Header = detail::CompressedStreamHeader;
+        std::array<std::byte, Header::Size> header;
+        m_source.Read(header.data(), header.size());
+        for (std::size_t i = 0; i < Header::Magic.size(); ++i) {
+            ZEN_ENSURE_WITH_MSG(
+                header[i] == static_cast<std::byte>(Header::Magic[i]),
+                "Not a compressed archive");
+        }
+        auto version = std::to_integer<std::uint8_t>(header[4]);
+        ZEN_ENSURE_WITH_MSG(
+            version == Header::Version,
+            fmt::format("Unsupported compressed stream version {}", version));
+        auto codec = static_cast<Codec>(header[5]);
+        ZEN_ENSURE_WITH_MSG(
+            codec == m_options.codec,
+            fmt::format("Compression codec mismatch, expect {}, got {}",
+                        static_cast<int>(m_options.codec),
+                        static_cast<int>(codec)));
+        detail::EnsureCodec(codec);
+    }
+
+    TSource &GetSource() { return m_source; }
+
+    void Read(void *data, std::size_t size)
+    {
+        auto out = static_cast<std::byte *>(data);
+        while (size > 0) {
+            if (m_pos == m_block.size()) {
+                NextBlock();
+            }
+            auto n = std::min(size, m_block.size() - m_pos);
+            std::memcpy(out, m_block.data() + m_pos, n);
+            m_pos += n;
+            out += n;
+            size -= n;
+        }
+    }
+
+private:
+    void NextBlock()
+    {
+        Prefetch();
+        // more data is needed than the segment holds, go on with the next one
+        while (m_pending.empty()) {
+            m_segment_end = false;
+            Prefetch();
+        }
+        m_block = m_pending.front().get();
+        m_pending.pop_front();
+        m_pos = 0;
+        Prefetch();
+    }
+
+    void Prefetch()
+    {
+        while (!m_segment_end && m_pending.size() < m_options.MaxInFlight()) {
+            std::array<std::byte, detail::FrameHeaderSize> header;
+            m_source.Read(header.data(), header.size());
+            auto [stored, raw] = detail::LoadFrameHeader(header.data());
+            if (stored == 0 && raw == 0) {
+                m_segment_end = true;
+                return;
+            }
+            std::vector<std::byte> payload(stored);
+            m_source.Read(payload.data(), payload.size());
+            m_pending.push_back(m_options.Pool().Submit(
+                [codec = m_options.codec, raw,
+                 payload = std::move(payload)] {
+                    return detail::DecodeFrame(codec, payload, raw);
+                }));
+        }
+    }
+};
+
+using CompressedBinarySerializer =
+    BasicBinarySerializer<CompressingSink<StreamSink>>;
+using CompressedBinaryDeserializer =
+    BasicBinaryDeserializer<DecompressingSource<StreamSource>>;
+
+} // namespace zen
@@ -0,0 +1,30 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file crc32c.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 10:12:40, October 21, 2025
+ */
+#pragma once
+#include <zen_serialization_export.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace zen::detail
+{
+
+/// CRC-32C (Castagnoli) of `size` bytes, continuing from a previous `crc`.
+/// Uses the SSE4.2 crc32 instruction on three interleaved streams combined
+/// with PCLMUL when available, and a slicing-by-8 table otherwise.
+ZEN_SERIALIZATION_EXPORT std::uint32_t Crc32c(const void *data,
+                                              std::size_t size,
+                                              std::uint32_t crc = 0);
+
+/// portable reference implementation
+ZEN_SERIALIZATION_EXPORT std::uint32_t Crc32cScalar(const void *data,
+                                                    std::size_t size,
+                                                    std::uint32_t crc = 0);
+
+} // namespace zen::detail
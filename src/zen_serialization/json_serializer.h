@@ -7,6 +7,7 @@
  * @date: 18:50:48, September 18, 2025
  */
 #pragma once
+#include "lazy.h"
 #include "range_size.h"
 #include <zen_serialization_export.h>
 
@@ -20,7 +21,7 @@ namespace zen
 
 class JsonSerializer
 {
-    std::ostream &m_stream;
+    std::ostream *m_stream;
     std::vector<nlohmann::json> m_objects;
     std::vector<std::string> m_next_names;
     std::size_t m_idx = 0;
@@ -49,14 +50,29 @@ class JsonSerializer
 
 public:
     JsonSerializer(std::ostream &stream, int indentation = -1)
-        : m_stream(stream), m_indentation(indentation)
+        : m_stream(&stream), m_indentation(indentation)
     {
         m_objects.emplace_back(nlohmann::json::object());
     }
 
     static constexpr bool IsBinary() { return false; }
 
-    void Flush() { m_stream << Json().dump(m_indentation); }
+    void Flush() { *m_stream << Json().dump(m_indentation); }
+
+    /// starts a new document, written to the same stream on Flush()
+    void Reset()
+    {
+        m_objects.clear();
+        m_objects.emplace_back(nlohmann::json::object());
+        m_next_names.clear();
+        m_idx = 0;
+    }
+
+    void Rebind(std::ostream &stream)
+    {
+        m_stream = &stream;
+        Reset();
+    }
 
     void SetNextName(std::string_view name) { m_next_names.emplace_back(name); }
 
@@ -93,7 +109,8 @@ public:
     }
 
     template <typename T>
-        requires std::is_arithmetic_v<T> || std::is_same_v<T, std::string>
+        requires std::is_arithmetic_v<T> || std::is_same_v<T, std::string> ||
+                 std::is_same_v<T, std::string_view>
     void operator()(const T &t)
     {
         auto &current = m_objects.back();
@@ -152,6 +169,23 @@ public:
 
     void Flush() {}
 
+    /// reads the document again from its start
+    void Reset()
+    {
+        m_objects.clear();
+        m_objects.push_back(m_json);
+        m_next_names.clear();
+        m_arr_idxes.clear();
+        m_idx = 0;
+    }
+
+    /// parses the next document of `stream`
+    void Rebind(std::istream &stream)
+    {
+        stream >> m_json;
+        Reset();
+    }
+
     void SetNextName(std::string_view name) { m_next_names.emplace_back(name); }
 
     void NewObject()
@@ -191,6 +225,41 @@ public:
     }
     void FinishArray() { FinishObject(); }
 
+    /// remembers the node of a Lazy payload, which stays valid as long as
+    /// the deserializer lives, and moves past it
+    detail::LazyPayload SkipPayload()
+    {
+        json &current = m_objects.back();
+        detail::LazyPayload payload{.deferred = true, .parent = &current};
+        if (current.is_object()) {
+            payload.name = NextName();
+        } else if (current.is_array()) {
+            payload.index = m_arr_idxes.back()++;
+        } else {
+            ZEN_THROW(fmt::format("cannot skip payload, current is {}",
+                                  current.type_name()));
+        }
+        return payload;
+    }
+
+    /// makes the parent of a skipped payload current, positioned at it
+    std::size_t ResumePayload(const detail::LazyPayload &payload)
+    {
+        json &parent = *static_cast<json *>(payload.parent);
+        m_objects.emplace_back(parent);
+        if (parent.is_array()) {
+            m_arr_idxes.push_back(payload.index);
+        } else {
+            m_next_names.push_back(payload.name);
+        }
+        return 0;
+    }
+
+    void LeavePayload(const detail::LazyPayload &, std::size_t)
+    {
+        FinishObject();
+    }
+
     void operator()(RangeSize &size)
     {
         json &current = m_objects.back();
@@ -222,6 +291,19 @@ public:
             ZEN_THROW(fmt::format("Invalid json type {}", current.type_name()));
         }
     }
+
+    /// borrows the string stored in the parsed json document
+    void operator()(std::string_view &str)
+    {
+        json &current = m_objects.back();
+        if (current.is_object()) {
+            str = current[NextName()].get_ref<const std::string &>();
+        } else if (current.is_array()) {
+            str = current[m_arr_idxes.back()++].get_ref<const std::string &>();
+        } else {
+            ZEN_THROW(fmt::format("Invalid json type {}", current.type_name()));
+        }
+    }
 };
 
 } // namespace zen
\ No newline at end of file
@@ -0,0 +1,115 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file lazy.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 10:42:17, October 22, 2025
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace zen
+{
+namespace detail
+{
+/// Where a skipped Lazy payload lives, filled in by the deserializer that
+/// skipped it and handed back to it when the payload is decoded.
+struct LazyPayload {
+    /// false if the payload could not be skipped and is to be read in place
+    bool deferred{false};
+    /// binary: byte range of the payload in the source
+    std::uint64_t offset{0};
+    std::uint64_t size{0};
+    /// json: the object or array holding the payload and its key/index in it
+    void *parent{nullptr};
+    std::string name;
+    std::size_t index{0};
+};
+} // namespace detail
+
+/**
+ * @brief Member that is decoded on first access instead of with its owner.
+ *
+ * Binary archives store the payload length-prefixed, so loading only records
+ * where it is and skips it; json archives keep a reference to its node. The
+ * first get() decodes the payload through the archive that loaded it, which
+ * must still be alive then, as must the buffer or stream it reads from.
+ * Sources that cannot seek back (compressed or checksummed streams, streams
+ * without seeking) load the payload right away.
+ *
+ * A payload may refer to objects written before it, but objects first
+ * written inside it are not shared with the rest of the archive: a later
+ * reference from outside stores and loads a separate copy.
+ *
+ * Not thread safe, concurrent first calls of get() must be synchronized.
+ */
+template <typename T>
+class Lazy
+{
+    mutable std::optional<T> m_value;
+    mutable std::function<void(T &)> m_loader;
+
+public:
+    Lazy() : m_value(std::in_place) {}
+
+    Lazy(T value) : m_value(std::move(value)) {}
+
+    Lazy &operator=(T value)
+    {
+        m_value = std::move(value);
+        m_loader = nullptr;
+        return *this;
+    }
+
+    /// whether the value is in memory, i.e. assigned or already decoded
+    bool IsLoaded() const { return m_value.has_value(); }
+
+    const T &get() const
+    {
+        if (!m_value) {
+            Load();
+        }
+        return *m_value;
+    }
+
+    T &get()
+    {
+        if (!m_value) {
+            Load();
+        }
+        return *m_value;
+    }
+
+    const T &operator*() const { return get(); }
+
+    T &operator*() { return get(); }
+
+    const T *operator->() const { return &get(); }
+
+    T *operator->() { return &get(); }
+
+    /// drops the value, the next get() calls `loader` to produce it
+    void Defer(std::function<void(T &)> loader)
+    {
+        m_value.reset();
+        m_loader = std::move(loader);
+    }
+
+private:
+    void Load() const
+    {
+        T value{};
+        if (m_loader) {
+            // kept until it succeeds, so a failed load can be retried
+            m_loader(value);
+            m_loader = nullptr;
+        }
+        m_value = std::move(value);
+    }
+};
+} // namespace zen
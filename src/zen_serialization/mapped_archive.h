@@ -0,0 +1,59 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file mapped_archive.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 10:36:12, October 18, 2025
+ */
+#pragma once
+#include "archive.h"
+#include "mapped_file.h"
+
+namespace zen
+{
+
+namespace detail
+{
+// keeps the mapping alive before the archive base class is constructed
+struct MappedFileHolder {
+    MappedFile m_file;
+};
+} // namespace detail
+
+/**
+ * @brief Binary input archive reading straight from a memory mapped file.
+ *
+ * Loading runs at page cache speed and borrowed members (see InArchive) point
+ * into the mapping, so they stay valid as long as this archive is alive.
+ */
+class MappedInArchive : private detail::MappedFileHolder, public InArchive
+{
+public:
+    explicit MappedInArchive(const std::filesystem::path &path)
+        : MappedFileHolder{MappedFile::OpenRead(path)},
+          InArchive(BufferBinaryDeserializer{m_file.Bytes()})
+    {
+    }
+
+    std::span<const std::byte> Bytes() const { return m_file.Bytes(); }
+};
+
+/**
+ * @brief Binary output archive writing into a memory mapped file.
+ *
+ * `capacity` bytes are preallocated up front and doubled whenever they run
+ * out; Flush() truncates the file to the serialized size.
+ */
+class MappedOutArchive : public OutArchive
+{
+public:
+    explicit MappedOutArchive(
+        const std::filesystem::path &path,
+        std::size_t capacity = MappedFileSink::DefaultCapacity)
+        : OutArchive(MappedBinarySerializer{MappedFileSink{path, capacity}})
+    {
+    }
+};
+
+} // namespace zen
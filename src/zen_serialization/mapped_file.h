@@ -0,0 +1,71 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file mapped_file.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 09:41:26, October 18, 2025
+ */
+#pragma once
+#include <zen_serialization_export.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace zen
+{
+
+/// RAII wrapper around a memory mapped file.
+class ZEN_SERIALIZATION_EXPORT MappedFile
+{
+public:
+    MappedFile() = default;
+
+    /// Maps an existing file read-only and hints the kernel that it will be
+    /// read sequentially and soon.
+    static MappedFile OpenRead(const std::filesystem::path &path);
+
+    /// Creates (or truncates) a file, preallocates `capacity` bytes on disk
+    /// and maps it read-write.
+    static MappedFile Create(const std::filesystem::path &path,
+                             std::size_t capacity);
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile();
+
+    bool IsOpen() const;
+
+    std::byte *Data() const { return m_data; }
+
+    std::size_t Size() const { return m_size; }
+
+    std::span<const std::byte> Bytes() const { return {m_data, m_size}; }
+
+    /// Changes the file size and remaps it, only valid for writable files.
+    /// Pointers obtained from Data() before the call are invalidated.
+    void Resize(std::size_t size);
+
+    void Close();
+
+private:
+    void Map();
+    void Unmap();
+
+    std::byte *m_data{nullptr};
+    std::size_t m_size{0};
+    bool m_writable{false};
+#ifdef _WIN32
+    void *m_file{nullptr};
+    void *m_mapping{nullptr};
+#else
+    int m_fd{-1};
+#endif
+};
+
+} // namespace zen
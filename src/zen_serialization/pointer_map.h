@@ -0,0 +1,118 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file pointer_map.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 10:12:41, November 2, 2025
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace zen::detail
+{
+
+/**
+ * @brief Open addressing map from object addresses to pointer ids.
+ *
+ * Slots live in one power of two sized array that is probed linearly and
+ * kept at most 3/4 full, so lookups touch one or two cache lines and
+ * inserting allocates only when the table doubles. Addresses are never null
+ * and ids never 0, which marks empty slots.
+ */
+class PointerMap
+{
+    struct Slot {
+        const void *address{nullptr};
+        std::uint64_t id{0};
+    };
+    std::vector<Slot> m_slots;
+    std::size_t m_size{0};
+
+    static std::size_t Hash(const void *address)
+    {
+        // fmix64 of MurmurHash3, addresses share their low and high bits
+        auto x = static_cast<std::uint64_t>(
+            reinterpret_cast<std::uintptr_t>(address));
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        return static_cast<std::size_t>(x);
+    }
+
+    void Rehash(std::size_t capacity)
+    {
+        std::vector<Slot> slots(capacity);
+        std::swap(slots, m_slots);
+        for (const auto &slot : slots) {
+            if (slot.id != 0) {
+                Place(slot);
+            }
+        }
+    }
+
+    void Place(const Slot &slot)
+    {
+        auto mask = m_slots.size() - 1;
+        for (auto i = Hash(slot.address) & mask;; i = (i + 1) & mask) {
+            if (m_slots[i].id == 0) {
+                m_slots[i] = slot;
+                return;
+            }
+        }
+    }
+
+public:
+    /// makes room for `n` entries without rehashing
+    void Reserve(std::size_t n)
+    {
+        auto capacity = std::bit_ceil(n + n / 3 + 1);
+        if (capacity > m_slots.size()) {
+            Rehash(capacity);
+        }
+    }
+
+    /// id of `address`, 0 if it is not in the map
+    std::uint64_t Find(const void *address) const
+    {
+        if (m_size == 0) {
+            return 0;
+        }
+        auto mask = m_slots.size() - 1;
+        for (auto i = Hash(address) & mask;; i = (i + 1) & mask) {
+            const auto &slot = m_slots[i];
+            if (slot.address == address || slot.id == 0) {
+                return slot.id;
+            }
+        }
+    }
+
+    /// `address` must not be in the map yet
+    void Insert(const void *address, std::uint64_t id)
+    {
+        if ((m_size + 1) * 4 > m_slots.size() * 3) {
+            Rehash(std::max<std::size_t>(m_slots.size() * 2, 16));
+        }
+        Place(Slot{address, id});
+        ++m_size;
+    }
+
+    std::size_t Size() const { return m_size; }
+
+    /// removes all entries but keeps the table
+    void Clear()
+    {
+        if (m_size != 0) {
+            std::fill(m_slots.begin(), m_slots.end(), Slot{});
+            m_size = 0;
+        }
+    }
+};
+
+} // namespace zen::detail
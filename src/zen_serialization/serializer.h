@@ -9,8 +9,12 @@
 #pragma once
 
 #include "binary_serializer.h"
+#include "checksum.h"
+#include "compression.h"
 #include "json_serializer.h"
 
+#include <optional>
+#include <utility>
 #include <variant>
 
 namespace zen
@@ -33,6 +37,226 @@ struct Serializer {
         return std::visit([](auto &s) { return s.IsBinary(); }, ser);
     }
 
+    /// whether contiguous ranges of bitwise serializable elements can be
+    /// written/read as raw bytes
+    bool SupportsBulkCopy() const
+    {
+        return std::visit(
+            [](auto &s) {
+                if constexpr (requires { s.SupportsBulkCopy(); }) {
+                    return s.SupportsBulkCopy();
+                } else {
+                    return false;
+                }
+            },
+            ser);
+    }
+
+    bool IsIndexed() const
+    {
+        return std::visit(
+            [](auto &s) {
+                if constexpr (requires { s.IsIndexed(); }) {
+                    return s.IsIndexed();
+                } else {
+                    return false;
+                }
+            },
+            ser);
+    }
+
+    bool IsTagged() const
+    {
+        return std::visit(
+            [](auto &s) {
+                if constexpr (requires { s.IsTagged(); }) {
+                    return s.IsTagged();
+                } else {
+                    return false;
+                }
+            },
+            ser);
+    }
+
+    bool UsesTypeIds() const
+    {
+        return std::visit(
+            [](auto &s) {
+                if constexpr (requires { s.UsesTypeIds(); }) {
+                    return s.UsesTypeIds();
+                } else {
+                    return false;
+                }
+            },
+            ser);
+    }
+
+    /// false if a tagged archive being read has no field `name`
+    bool BeginField(std::string_view name, std::uint32_t id)
+    {
+        return std::visit(
+            [&](auto &s) {
+                if constexpr (requires { s.BeginField(name, id); }) {
+                    using R = decltype(s.BeginField(name, id));
+                    if constexpr (std::same_as<R, bool>) {
+                        return s.BeginField(name, id);
+                    } else {
+                        s.BeginField(name, id);
+                        return true;
+                    }
+                } else {
+                    return true;
+                }
+            },
+            ser);
+    }
+
+    void FinishField()
+    {
+        std::visit(
+            [](auto &s) {
+                if constexpr (requires { s.FinishField(); }) {
+                    s.FinishField();
+                }
+            },
+            ser);
+    }
+
+    bool IndexesElements(std::size_t n) const
+    {
+        return std::visit(
+            [n](auto &s) {
+                if constexpr (requires { s.IndexesElements(n); }) {
+                    return s.IndexesElements(n);
+                } else {
+                    return false;
+                }
+            },
+            ser);
+    }
+
+    void NextElement(std::size_t i)
+    {
+        std::visit(
+            [i](auto &s) {
+                if constexpr (requires { s.NextElement(i); }) {
+                    s.NextElement(i);
+                }
+            },
+            ser);
+    }
+
+    void NotePointer(std::uint64_t id, bool first)
+    {
+        std::visit(
+            [=](auto &s) {
+                if constexpr (requires { s.NotePointer(id, first); }) {
+                    s.NotePointer(id, first);
+                }
+            },
+            ser);
+    }
+
+    /// name keyed formats need no seeking, positional ones need an index
+    void Seek(std::string_view name)
+    {
+        std::visit(
+            [name](auto &s) {
+                using S = std::remove_cvref_t<decltype(s)>;
+                if constexpr (requires { s.Seek(name); }) {
+                    s.Seek(name);
+                } else if constexpr (S::IsBinary()) {
+                    ZEN_THROW(fmt::format("{} does not support seeking",
+                                          typeid(s).name()));
+                }
+            },
+            ser);
+    }
+
+    /// see BasicBinaryDeserializer::SeekRange(), std::nullopt for name
+    /// keyed formats
+    template <typename T>
+    std::optional<std::pair<std::size_t, std::size_t>>
+    SeekRange(std::string_view name, std::size_t first)
+    {
+        return std::visit(
+            [&](auto &s)
+                -> std::optional<std::pair<std::size_t, std::size_t>> {
+                using S = std::remove_cvref_t<decltype(s)>;
+                if constexpr (requires {
+                                  s.template SeekRange<T>(name, first);
+                              }) {
+                    return s.template SeekRange<T>(name, first);
+                } else if constexpr (S::IsBinary()) {
+                    ZEN_THROW(fmt::format("{} does not support seeking",
+                                          typeid(s).name()));
+                } else {
+                    return std::nullopt;
+                }
+            },
+            ser);
+    }
+
+    // Lazy payloads, formats without explicit support read them in place
+    void BeginPayload()
+    {
+        std::visit(
+            [](auto &s) {
+                if constexpr (requires { s.BeginPayload(); }) {
+                    s.BeginPayload();
+                }
+            },
+            ser);
+    }
+
+    void EndPayload()
+    {
+        std::visit(
+            [](auto &s) {
+                if constexpr (requires { s.EndPayload(); }) {
+                    s.EndPayload();
+                }
+            },
+            ser);
+    }
+
+    LazyPayload SkipPayload()
+    {
+        return std::visit(
+            [](auto &s) {
+                if constexpr (requires { s.SkipPayload(); }) {
+                    return s.SkipPayload();
+                } else {
+                    return LazyPayload{};
+                }
+            },
+            ser);
+    }
+
+    std::size_t ResumePayload(const LazyPayload &payload)
+    {
+        return std::visit(
+            [&](auto &s) -> std::size_t {
+                if constexpr (requires { s.ResumePayload(payload); }) {
+                    return s.ResumePayload(payload);
+                } else {
+                    return 0;
+                }
+            },
+            ser);
+    }
+
+    void LeavePayload(const LazyPayload &payload, std::size_t pos)
+    {
+        std::visit(
+            [&](auto &s) {
+                if constexpr (requires { s.LeavePayload(payload, pos); }) {
+                    s.LeavePayload(payload, pos);
+                }
+            },
+            ser);
+    }
+
     void Flush()
     {
         std::visit(
@@ -44,10 +268,48 @@ struct Serializer {
             ser);
     }
 
+    /// starts a new archive at the current position of the sink or source
+    void Reset()
+    {
+        std::visit(
+            [](auto &s) {
+                if constexpr (requires { s.Reset(); }) {
+                    s.Reset();
+                }
+            },
+            ser);
+    }
+
+    /// starts a new archive on the sink or source made from `target`, e.g. a
+    /// byte buffer or a stream
+    template <typename T>
+    void Rebind(T &&target)
+    {
+        std::visit(
+            [&](auto &s) {
+                if constexpr (requires { s.Rebind(std::forward<T>(target)); }) {
+                    s.Rebind(std::forward<T>(target));
+                } else {
+                    ZEN_THROW(fmt::format("{} cannot be rebound to {}",
+                                          typeid(s).name(), typeid(T).name()));
+                }
+            },
+            ser);
+    }
+
     template <typename... Ts>
     void operator()(Ts &&...args)
     {
-        std::visit([&](auto &s) { s(args...); }, ser);
+        std::visit(
+            [&](auto &s) {
+                if constexpr (std::is_invocable_v<decltype(s), Ts &...>) {
+                    s(args...);
+                } else {
+                    ZEN_THROW(fmt::format("{} does not support this operation",
+                                          typeid(s).name()));
+                }
+            },
+            ser);
     }
 
     void SetNextName(std::string_view name)
@@ -108,13 +370,22 @@ struct Serializer {
 } // namespace detail
 
 #ifndef ZEN_SERIALIZATION_OUT_SERIALIZER
-using OutSerializer = detail::Serializer<JsonSerializer, BinarySerializer>;
+using OutSerializer =
+    detail::Serializer<JsonSerializer, BinarySerializer, BufferBinarySerializer,
+                       SpanBinarySerializer, MappedBinarySerializer,
+                       SizeSerializer, CompressedBinarySerializer,
+                       ChecksummedBinarySerializer,
+                       BufferChecksummedBinarySerializer>;
 #else
 using OutSerializer = detail::Serializer<ZEN_SERIALIZATION_OUT_SERIALIZER>;
 #endif
 
 #ifndef ZEN_SERIALIZATION_IN_DESERIALIZER
-using InDeserializer = detail::Serializer<JsonDeserializer, BinaryDeserializer>;
+using InDeserializer =
+    detail::Serializer<JsonDeserializer, BinaryDeserializer,
+                       BufferBinaryDeserializer, CompressedBinaryDeserializer,
+                       ChecksummedBinaryDeserializer,
+                       BufferChecksummedBinaryDeserializer>;
 #else
 using InDeserializer = detail::Serializer<ZEN_SERIALIZATION_IN_DESERIALIZER>;
 #endif
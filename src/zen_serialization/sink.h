@@ -0,0 +1,222 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file sink.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 20:12:31, October 17, 2025
+ */
+#pragma once
+#include "archive_base.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace zen
+{
+
+/// A sink receives the raw bytes produced by a binary serializer.
+template <typename T>
+concept Sink = requires(T &sink, const void *data, std::size_t size) {
+    sink.Write(data, size);
+};
+
+/// Sinks that only measure the output; serializers may skip encoding bytes
+/// nobody reads and just Advance() by their size.
+template <typename T>
+concept CountingSink = Sink<T> && requires(T &sink, std::size_t size) {
+    sink.Advance(size);
+};
+
+/// Adapter writing into a std::ostream. Small writes are batched into a local
+/// buffer so the stream is only touched once per `BufferSize` bytes.
+class StreamSink
+{
+    static constexpr std::size_t BufferSize = 4096;
+
+    std::ostream *m_stream;
+    std::size_t m_size{0};
+    std::array<char, BufferSize> m_buffer;
+
+public:
+    StreamSink(std::ostream &stream) : m_stream(&stream) {}
+
+    StreamSink(StreamSink &&other) noexcept
+        : m_stream(other.m_stream), m_size(other.m_size)
+    {
+        std::memcpy(m_buffer.data(), other.m_buffer.data(), m_size);
+        other.m_size = 0;
+    }
+
+    StreamSink(const StreamSink &) = delete;
+    StreamSink &operator=(const StreamSink &) = delete;
+
+    ~StreamSink()
+    {
+        if (m_size > 0) {
+            m_stream->write(m_buffer.data(),
+                            static_cast<std::streamsize>(m_size));
+        }
+    }
+
+    void Write(const void *data, std::size_t size)
+    {
+        if (m_size + size > BufferSize) {
+            Flush();
+            if (size > BufferSize) {
+                WriteToStream(static_cast<const char *>(data), size);
+                return;
+            }
+        }
+        std::memcpy(m_buffer.data() + m_size, data, size);
+        m_size += size;
+    }
+
+    void Flush()
+    {
+        WriteToStream(m_buffer.data(), m_size);
+        m_size = 0;
+        m_stream->flush();
+    }
+
+private:
+    void WriteToStream(const char *data, std::size_t size)
+    {
+        auto n = static_cast<std::streamsize>(size);
+        if (n > 0 && m_stream->rdbuf()->sputn(data, n) != n) {
+            m_stream->setstate(std::ios::badbit);
+            ZEN_THROW(fmt::format("Failed to write {} bytes to stream", n));
+        }
+    }
+};
+
+/// Growable contiguous byte buffer. The vector grows geometrically and is
+/// trimmed to the written size on Flush(), so every write costs one capacity
+/// check plus a memcpy.
+class BufferSink
+{
+    std::vector<std::byte> *m_buffer;
+    std::size_t m_size{0};
+
+public:
+    BufferSink(std::vector<std::byte> &buffer) : m_buffer(&buffer)
+    {
+        m_buffer->clear();
+    }
+
+    /// Sizes the buffer for `capacity` bytes up front, e.g. the result of a
+    /// SizeArchive pass, so serializing needs no further allocation.
+    BufferSink(std::vector<std::byte> &buffer, std::size_t capacity)
+        : BufferSink(buffer)
+    {
+        m_buffer->resize(capacity);
+    }
+
+    void Write(const void *data, std::size_t size)
+    {
+        if (m_size + size > m_buffer->size()) {
+            Grow(m_size + size);
+        }
+        std::memcpy(m_buffer->data() + m_size, data, size);
+        m_size += size;
+    }
+
+    void Flush() { m_buffer->resize(m_size); }
+
+    std::size_t Size() const { return m_size; }
+
+private:
+    void Grow(std::size_t required)
+    {
+        m_buffer->resize(std::max({required, 2 * m_buffer->size(),
+                                   std::size_t{256}}));
+    }
+};
+
+/// Fixed-size span of memory; throws if the serialized data does not fit.
+class SpanSink
+{
+    std::span<std::byte> m_span;
+    std::size_t m_size{0};
+
+public:
+    SpanSink(std::span<std::byte> span) : m_span(span) {}
+
+    void Write(const void *data, std::size_t size)
+    {
+        if (size > m_span.size() - m_size) {
+            ZEN_THROW(fmt::format("Span sink overflow: {} + {} > {} bytes",
+                                  m_size, size, m_span.size()));
+        }
+        std::memcpy(m_span.data() + m_size, data, size);
+        m_size += size;
+    }
+
+    std::size_t Size() const { return m_size; }
+
+    std::span<std::byte> Written() const { return m_span.first(m_size); }
+};
+
+/// Discards the data and only counts its size, see SizeArchive.
+class SizeSink
+{
+    std::size_t m_size{0};
+
+public:
+    void Write(const void *, std::size_t size) { m_size += size; }
+
+    void Advance(std::size_t size) { m_size += size; }
+
+    std::size_t Size() const { return m_size; }
+};
+
+/// Memory mapped output file. Space is preallocated in `capacity` steps that
+/// double when exhausted, Flush() truncates the file to the bytes written.
+class MappedFileSink
+{
+    MappedFile m_file;
+    std::size_t m_size{0};
+
+public:
+    static constexpr std::size_t DefaultCapacity = std::size_t{1} << 20;
+
+    MappedFileSink(const std::filesystem::path &path,
+                   std::size_t capacity = DefaultCapacity)
+        : m_file(MappedFile::Create(path, std::max(capacity, std::size_t{1})))
+    {
+    }
+
+    MappedFileSink(MappedFileSink &&) noexcept = default;
+
+    ~MappedFileSink()
+    {
+        if (m_file.IsOpen() && m_file.Size() != m_size) {
+            try {
+                m_file.Resize(m_size);
+            } catch (...) {
+            }
+        }
+    }
+
+    void Write(const void *data, std::size_t size)
+    {
+        if (m_size + size > m_file.Size()) {
+            m_file.Resize(std::max(m_size + size, 2 * m_file.Size()));
+        }
+        std::memcpy(m_file.Data() + m_size, data, size);
+        m_size += size;
+    }
+
+    void Flush() { m_file.Resize(m_size); }
+
+    std::size_t Size() const { return m_size; }
+};
+
+} // namespace zen
@@ -0,0 +1,46 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file size_archive.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 09:42:18, October 20, 2025
+ */
+#pragma once
+#include "archive.h"
+
+namespace zen
+{
+
+/**
+ * @brief Computes the exact size of a binary archive without producing it.
+ *
+ * Runs the same serialize functions and pointer tracking as OutArchive with a
+ * binary serializer of the same `options`, but the bytes are only counted:
+ * bulk ranges add their size and varints are measured instead of encoded.
+ * The result allows sizing the target in one go, e.g.
+ *
+ *   SizeArchive sizer;
+ *   sizer(make_nvp("scene", scene));
+ *   std::vector<std::byte> buffer;
+ *   OutArchive oar{BufferBinarySerializer{BufferSink{buffer, sizer.Size()}}};
+ *   oar(make_nvp("scene", scene));
+ */
+class SizeArchive : public OutArchive
+{
+public:
+    explicit SizeArchive(BinaryOptions options = {})
+        : OutArchive(SizeSerializer{SizeSink{}, options})
+    {
+    }
+
+    /// number of bytes serialized so far, including the binary header and
+    /// the index Flush() appends to indexed archives
+    std::size_t Size()
+    {
+        auto &serializer = std::get<SizeSerializer>(Serializer().ser);
+        return serializer.GetSink().Size() + serializer.PendingIndexSize();
+    }
+};
+
+} // namespace zen
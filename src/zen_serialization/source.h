@@ -0,0 +1,161 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file source.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 20:14:02, October 17, 2025
+ */
+#pragma once
+#include "archive_base.h"
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <ranges>
+#include <span>
+
+namespace zen
+{
+
+/// A source provides the raw bytes consumed by a binary deserializer.
+template <typename T>
+concept Source = requires(T &source, void *data, std::size_t size) {
+    source.Read(data, size);
+};
+
+/// A source that can hand out views into its own storage instead of copying.
+template <typename T>
+concept BorrowingSource =
+    Source<T> && requires(T &source, std::size_t size) {
+        { source.Borrow(size) } -> std::same_as<std::span<const std::byte>>;
+        { source.Remaining() } -> std::same_as<std::span<const std::byte>>;
+    };
+
+/// A source that can jump to absolute positions, counted from where the
+/// archive starts. Needed to read indexed archives out of order.
+template <typename T>
+concept SeekableSource =
+    Source<T> && requires(T &source, std::size_t pos) {
+        source.Seek(pos);
+        { source.Position() } -> std::convertible_to<std::size_t>;
+        { source.Size() } -> std::convertible_to<std::size_t>;
+    };
+
+/// Adapter reading from a std::istream. Reads go straight to the stream
+/// buffer, so nothing past the archive is consumed from the stream.
+class StreamSource
+{
+    std::istream *m_stream;
+    /// stream position of the archive start, -1 if the stream cannot seek
+    std::streamoff m_start;
+
+public:
+    StreamSource(std::istream &stream)
+        : m_stream(&stream),
+          m_start(stream.rdbuf()->pubseekoff(0, std::ios::cur, std::ios::in))
+    {
+    }
+
+    void Read(void *data, std::size_t size)
+    {
+        auto n = static_cast<std::streamsize>(size);
+        if (m_stream->rdbuf()->sgetn(static_cast<char *>(data), n) != n) {
+            m_stream->setstate(std::ios::failbit | std::ios::eofbit);
+            ZEN_THROW(fmt::format("Failed to read {} bytes from stream", n));
+        }
+    }
+
+    void Seek(std::size_t pos)
+    {
+        auto target = m_start + static_cast<std::streamoff>(pos);
+        if (m_start < 0 ||
+            m_stream->rdbuf()->pubseekpos(target, std::ios::in) != target) {
+            m_stream->setstate(std::ios::failbit);
+            ZEN_THROW(fmt::format("Failed to seek stream to {}", pos));
+        }
+    }
+
+    /// false for pipes and other streams without random access
+    bool Seekable() const { return m_start >= 0; }
+
+    std::size_t Position() const
+    {
+        return static_cast<std::size_t>(
+            m_stream->rdbuf()->pubseekoff(0, std::ios::cur, std::ios::in) -
+            m_start);
+    }
+
+    std::size_t Size() const
+    {
+        auto buf = m_stream->rdbuf();
+        auto pos = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+        auto end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+        buf->pubseekpos(pos, std::ios::in);
+        if (m_start < 0 || end < 0) {
+            ZEN_THROW("Stream does not support seeking");
+        }
+        return static_cast<std::size_t>(end - m_start);
+    }
+};
+
+/// Cursor over an in-memory buffer. Besides copying reads it can borrow
+/// ranges of the buffer, which is what enables zero-copy loading of
+/// std::string_view, std::span<const T> and BorrowedBlob members.
+class SpanSource
+{
+    std::span<const std::byte> m_span;
+    std::size_t m_pos{0};
+
+public:
+    SpanSource(std::span<const std::byte> span) : m_span(span) {}
+
+    template <std::ranges::contiguous_range Rng>
+        requires(sizeof(std::ranges::range_value_t<Rng>) == 1 &&
+                 !std::same_as<std::remove_cvref_t<Rng>,
+                               std::span<const std::byte>>)
+    SpanSource(const Rng &bytes)
+        : m_span(reinterpret_cast<const std::byte *>(std::ranges::data(bytes)),
+                 std::ranges::size(bytes))
+    {
+    }
+
+    void Read(void *data, std::size_t size)
+    {
+        std::memcpy(data, Borrow(size).data(), size);
+    }
+
+    std::span<const std::byte> Borrow(std::size_t size)
+    {
+        if (size > m_span.size() - m_pos) {
+            ZEN_THROW(fmt::format("Failed to read {} bytes, {} of {} left",
+                                  size, m_span.size() - m_pos, m_span.size()));
+        }
+        auto bytes = m_span.subspan(m_pos, size);
+        m_pos += size;
+        return bytes;
+    }
+
+    std::size_t Position() const { return m_pos; }
+
+    std::size_t Size() const { return m_span.size(); }
+
+    void Seek(std::size_t pos)
+    {
+        if (pos > m_span.size()) {
+            ZEN_THROW(fmt::format("Cannot seek to {}, buffer has {} bytes",
+                                  pos, m_span.size()));
+        }
+        m_pos = pos;
+    }
+
+    std::span<const std::byte> Remaining() const
+    {
+        return m_span.subspan(m_pos);
+    }
+
+    std::span<const std::byte> Buffer() const { return m_span; }
+};
+
+} // namespace zen
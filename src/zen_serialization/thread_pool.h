@@ -0,0 +1,66 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file thread_pool.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 14:05:47, October 20, 2025
+ */
+#pragma once
+#include <zen_serialization_export.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace zen
+{
+
+/// Fixed size pool of worker threads running tasks in submission order.
+class ZEN_SERIALIZATION_EXPORT ThreadPool
+{
+public:
+    /// `threads` == 0 uses one thread per hardware thread
+    explicit ThreadPool(std::size_t threads = 0);
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /// runs the tasks still queued, then joins the workers
+    ~ThreadPool();
+
+    std::size_t Size() const { return m_threads.size(); }
+
+    template <typename F>
+    auto Submit(F &&func) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+    {
+        using R = std::invoke_result_t<std::decay_t<F>>;
+        auto task =
+            std::make_shared<std::packaged_task<R()>>(std::forward<F>(func));
+        auto future = task->get_future();
+        Push([task = std::move(task)] { (*task)(); });
+        return future;
+    }
+
+    /// process wide pool shared by archives that are not given their own
+    static ThreadPool &Default();
+
+private:
+    void Push(std::function<void()> task);
+    void Run();
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stop{false};
+};
+
+} // namespace zen
@@ -0,0 +1,135 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file varint.h
+ * @author: Zen Shawn
+ * @email: xiaozisheng2008@hotmail.com
+ * @date: 15:21:09, October 18, 2025
+ */
+#pragma once
+#include "archive_base.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ZEN_SERIALIZATION_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace zen::detail
+{
+
+/// integers that are LEB128 encoded in compact mode
+template <typename T>
+constexpr bool is_varint_v =
+    std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) > 1);
+
+constexpr std::size_t MaxVarintSize = 10;
+
+template <typename T>
+constexpr std::uint64_t ZigZagEncode(T value)
+{
+    if constexpr (std::is_signed_v<T>) {
+        auto v = static_cast<std::int64_t>(value);
+        return (static_cast<std::uint64_t>(v) << 1) ^
+               static_cast<std::uint64_t>(v >> 63);
+    } else {
+        return static_cast<std::uint64_t>(value);
+    }
+}
+
+template <typename T>
+constexpr T ZigZagDecode(std::uint64_t value)
+{
+    if constexpr (std::is_signed_v<T>) {
+        return static_cast<T>(static_cast<std::int64_t>(value >> 1) ^
+                              -static_cast<std::int64_t>(value & 1));
+    } else {
+        return static_cast<T>(value);
+    }
+}
+
+/// writes `value` as LEB128 into `out`, returns the number of bytes written
+inline std::size_t EncodeVarint(std::uint64_t value, std::byte *out)
+{
+    std::size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = static_cast<std::byte>(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = static_cast<std::byte>(value);
+    return n;
+}
+
+inline std::size_t VarintSize(std::uint64_t value)
+{
+    // 1 + floor(bit_width / 7), with zero taking one byte
+    return 1 + static_cast<std::size_t>(std::bit_width(value | 1) - 1) / 7;
+}
+
+/// decodes one LEB128 value from the front of `in` into `value`, returns the
+/// number of bytes consumed
+inline std::size_t DecodeVarint(std::span<const std::byte> in,
+                                std::uint64_t &value)
+{
+    value = 0;
+    auto n = std::min(in.size(), MaxVarintSize);
+    for (std::size_t i = 0; i < n; ++i) {
+        auto byte = std::to_integer<std::uint64_t>(in[i]);
+        value |= (byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            return i + 1;
+        }
+    }
+    ZEN_THROW("Truncated or malformed varint");
+}
+
+/**
+ * @brief Decodes `out.size()` LEB128 values from the front of `in`.
+ *
+ * Runs of single byte values, the common case for sizes, indices and small
+ * integers, are detected 16 bytes at a time with SSE2 and widened without
+ * any per-value branching. Multi byte values fall back to DecodeVarint.
+ *
+ * @return the number of bytes consumed
+ */
+template <typename T>
+std::size_t DecodeVarints(std::span<const std::byte> in, std::span<T> out)
+{
+    std::size_t pos = 0;
+    std::size_t i = 0;
+#ifdef ZEN_SERIALIZATION_HAS_SSE2
+    while (out.size() - i >= 16 && in.size() - pos >= 16) {
+        auto chunk = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(in.data() + pos));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(chunk));
+        // number of leading bytes without continuation bit
+        auto k = mask == 0 ? 16u : static_cast<unsigned>(std::countr_zero(mask));
+        for (unsigned j = 0; j < k; ++j) {
+            out[i + j] =
+                ZigZagDecode<T>(std::to_integer<std::uint64_t>(in[pos + j]));
+        }
+        i += k;
+        pos += k;
+        if (k < 16) {
+            std::uint64_t value;
+            pos += DecodeVarint(in.subspan(pos), value);
+            out[i++] = ZigZagDecode<T>(value);
+        }
+    }
+#endif
+    for (; i < out.size(); ++i) {
+        std::uint64_t value;
+        pos += DecodeVarint(in.subspan(pos), value);
+        out[i] = ZigZagDecode<T>(value);
+    }
+    return pos;
+}
+
+} // namespace zen::detail
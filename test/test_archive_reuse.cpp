@@ -0,0 +1,189 @@
+#include <catch.hpp>
+#include <zen_serialization/archive_pool.h>
+
+#include <sstream>
+#include <thread>
+
+using namespace zen;
+
+namespace
+{
+struct Command {
+    virtual ~Command() = default;
+    std::string target;
+
+    SERIALIZE_MEMBER(target)
+};
+
+struct MoveCommand : Command {
+    double dx{0};
+    double dy{0};
+
+    SERIALIZE_MEMBER(BaseClass<Command>(this), dx, dy)
+};
+
+struct Request {
+    std::int64_t sequence{0};
+    std::string user;
+    std::vector<std::shared_ptr<Command>> commands;
+    std::map<std::string, std::string> headers;
+
+    SERIALIZE_MEMBER(sequence, user, commands, headers)
+};
+
+Request make_request(std::int64_t sequence)
+{
+    Request request{sequence, fmt::format("user{}", sequence % 7), {}, {}};
+    for (int i = 0; i < 3; ++i) {
+        auto command = std::make_shared<MoveCommand>();
+        command->target = fmt::format("node{}", i);
+        command->dx = static_cast<double>(sequence);
+        command->dy = i;
+        request.commands.push_back(command);
+        // the same command twice, as a reference
+        request.commands.push_back(command);
+    }
+    request.headers = {{"trace", fmt::format("{:08x}", sequence)},
+                       {"route", "primary"}};
+    return request;
+}
+
+void check_request(const Request &loaded, std::int64_t sequence)
+{
+    auto request = make_request(sequence);
+    CHECK(loaded.sequence == request.sequence);
+    CHECK(loaded.user == request.user);
+    CHECK(loaded.headers == request.headers);
+    REQUIRE(loaded.commands.size() == request.commands.size());
+    for (std::size_t i = 0; i < loaded.commands.size(); i += 2) {
+        auto command = std::dynamic_pointer_cast<MoveCommand>(loaded.commands[i]);
+        REQUIRE(command);
+        CHECK(command->dx == static_cast<double>(sequence));
+        CHECK(loaded.commands[i + 1] == loaded.commands[i]);
+    }
+}
+
+std::vector<std::byte> save_fresh(const Request &request,
+                                  BinaryOptions options)
+{
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{buffer, options}};
+    oar(make_nvp("request", request));
+    oar.Flush();
+    return buffer;
+}
+} // namespace
+
+REGISTER_CLASS(Command)
+REGISTER_CLASS(MoveCommand)
+
+TEST_CASE("archive-reuse", "[reuse][rebind]")
+{
+    for (auto options :
+         {BinaryOptions{}, BinaryOptions{.compact = true},
+          BinaryOptions{.indexed = true}, BinaryOptions{.tagged = true},
+          BinaryOptions{.string_table = true, .type_ids = true}}) {
+        std::vector<std::byte> buffer;
+        OutArchive oar{BufferBinarySerializer{buffer, options}};
+        std::unique_ptr<InArchive> iar;
+        for (std::int64_t sequence = 0; sequence < 20; ++sequence) {
+            auto request = make_request(sequence);
+            if (sequence > 0) {
+                oar.Rebind(buffer);
+            }
+            oar(make_nvp("request", request));
+            oar.Flush();
+            // pointer ids, string and type tables start over
+            REQUIRE(buffer == save_fresh(request, options));
+
+            if (!iar) {
+                iar = std::make_unique<InArchive>(
+                    BufferBinaryDeserializer{buffer, options});
+            } else {
+                iar->Rebind(std::span<const std::byte>(buffer));
+            }
+            Request loaded;
+            (*iar)(make_nvp("request", loaded));
+            check_request(loaded, sequence);
+        }
+    }
+}
+
+TEST_CASE("archive-reuse", "[reuse][reset]")
+{
+    BinaryOptions options{.compact = true, .type_ids = true};
+    std::stringstream ss;
+    {
+        OutArchive oar{BinarySerializer{ss, options}};
+        for (std::int64_t sequence = 0; sequence < 10; ++sequence) {
+            if (sequence > 0) {
+                oar.Reset();
+            }
+            oar(make_nvp("request", make_request(sequence)));
+        }
+    }
+    // one archive after the other on the same stream
+    InArchive iar{BinaryDeserializer{ss, options}};
+    for (std::int64_t sequence = 0; sequence < 10; ++sequence) {
+        if (sequence > 0) {
+            iar.Reset();
+        }
+        Request loaded;
+        iar(make_nvp("request", loaded));
+        check_request(loaded, sequence);
+    }
+}
+
+TEST_CASE("archive-reuse", "[reuse][json]")
+{
+    std::stringstream first, second;
+    OutArchive oar{JsonSerializer{first}};
+    oar(make_nvp("request", make_request(1)));
+    oar.Flush();
+    oar.Rebind(second);
+    oar(make_nvp("request", make_request(2)));
+    oar.Flush();
+
+    InArchive iar{JsonDeserializer{first}};
+    Request loaded;
+    iar(make_nvp("request", loaded));
+    check_request(loaded, 1);
+    iar.Rebind(second);
+    Request next;
+    iar(make_nvp("request", next));
+    check_request(next, 2);
+
+    // a binary archive cannot switch to a stream of another kind
+    std::vector<std::byte> buffer;
+    OutArchive binary{BufferBinarySerializer{buffer}};
+    CHECK_THROWS(binary.Rebind(second));
+}
+
+TEST_CASE("archive-reuse", "[reuse][pool]")
+{
+    auto worker = [](std::int64_t offset) {
+        BinaryOptions options{.compact = true};
+        std::vector<std::byte> message;
+        const std::byte *data = nullptr;
+        for (std::int64_t i = 0; i < 200; ++i) {
+            auto sequence = offset + i % 50;
+            ArchivePool::Save(message, options,
+                              make_nvp("request", make_request(sequence)));
+            Request loaded;
+            ArchivePool::Load(message, options, make_nvp("request", loaded));
+            check_request(loaded, sequence);
+            if (i == 50) {
+                data = message.data();
+            }
+        }
+        // the message buffer kept its capacity
+        CHECK(message.data() == data);
+        return &ArchivePool::Out(message, options);
+    };
+    auto main = worker(0);
+    CHECK(worker(0) == main);
+    OutArchive *other = nullptr;
+    std::thread thread([&] { other = worker(1000); });
+    thread.join();
+    CHECK(other != main);
+}
@@ -0,0 +1,191 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+
+#include <sstream>
+
+using namespace zen;
+
+namespace
+{
+struct Header {
+    std::string title;
+    std::int32_t version{0};
+
+    SERIALIZE_MEMBER(title, version)
+};
+
+struct Item {
+    std::string name;
+    std::vector<std::int16_t> data;
+
+    bool operator==(const Item &) const = default;
+
+    SERIALIZE_MEMBER(name, data)
+};
+
+struct Node {
+    std::string name;
+    std::shared_ptr<Node> next;
+
+    SERIALIZE_MEMBER(name, next)
+};
+
+struct Snapshot {
+    Header header{"snapshot", 3};
+    std::vector<Item> items;
+    std::vector<double> values;
+    std::shared_ptr<Node> graph;
+    std::map<std::string, std::string> metadata{{"author", "zen"},
+                                                {"tool", "tests"}};
+
+    Snapshot()
+    {
+        for (int i = 0; i < 5000; ++i) {
+            items.push_back({"item" + std::to_string(i),
+                             std::vector<std::int16_t>(i % 5, i % 100)});
+        }
+        for (int i = 0; i < 10000; ++i) {
+            values.push_back(i * 0.5);
+        }
+        graph = std::make_shared<Node>();
+        graph->name = "root";
+        graph->next = std::make_shared<Node>();
+        graph->next->name = "leaf";
+    }
+
+    template <typename Archive>
+    void save(Archive &ar)
+    {
+        ar(make_nvp("header", header), make_nvp("items", items),
+           make_nvp("values", values), make_nvp("graph", graph),
+           make_nvp("again", graph), make_nvp("metadata", metadata));
+    }
+};
+
+template <typename Archive>
+void check_random_access(Archive &iar, const Snapshot &snapshot)
+{
+    std::map<std::string, std::string> metadata;
+    iar.Seek("metadata")(make_nvp("metadata", metadata));
+    CHECK(metadata == snapshot.metadata);
+
+    Header header;
+    iar.Seek("header")(make_nvp("header", header));
+    CHECK(header.title == snapshot.header.title);
+    CHECK(header.version == snapshot.header.version);
+
+    std::vector<Item> items;
+    iar.LoadRange("items", 3000, 10, items);
+    REQUIRE(items.size() == 10);
+    CHECK(std::equal(items.begin(), items.end(),
+                     snapshot.items.begin() + 3000));
+
+    iar.LoadRange("items", 4999, 10, items);
+    REQUIRE(items.size() == 1);
+    CHECK(items[0] == snapshot.items.back());
+
+    std::vector<double> values;
+    iar.LoadRange("values", 9990, 20, values);
+    REQUIRE(values.size() == 10);
+    CHECK(values.front() == snapshot.values[9990]);
+    CHECK(values.back() == snapshot.values.back());
+
+    std::shared_ptr<Node> graph;
+    iar.Seek("graph")(make_nvp("graph", graph));
+    REQUIRE(graph);
+    CHECK(graph->next->name == "leaf");
+}
+} // namespace
+
+TEST_CASE("binary-index", "[index][buffer]")
+{
+    Snapshot snapshot;
+    for (auto options : {BinaryOptions{.indexed = true},
+                         BinaryOptions{.compact = true, .indexed = true},
+                         BinaryOptions{.portable = true, .indexed = true}}) {
+        std::vector<std::byte> buffer;
+        OutArchive oar{BufferBinarySerializer{buffer, options}};
+        snapshot.save(oar);
+        oar.Flush();
+
+        InArchive iar{BufferBinaryDeserializer{buffer, options}};
+        check_random_access(iar, snapshot);
+        // only written after the graph it points into
+        CHECK_THROWS(iar.Seek("again"));
+        CHECK_THROWS(iar.Seek("missing"));
+
+        // the index does not get in the way of reading everything in order
+        Snapshot loaded;
+        loaded.items.clear();
+        loaded.values.clear();
+        loaded.graph.reset();
+        InArchive iar2{BufferBinaryDeserializer{buffer, options}};
+        loaded.save(iar2);
+        CHECK(loaded.items == snapshot.items);
+        CHECK(loaded.values == snapshot.values);
+        CHECK(loaded.graph->next->name == "leaf");
+    }
+}
+
+TEST_CASE("binary-index", "[index][stream]")
+{
+    Snapshot snapshot;
+    BinaryOptions options{.compact = true, .indexed = true};
+    std::stringstream ss;
+    ss << "prefix";
+    {
+        OutArchive oar{BinarySerializer{ss, options}};
+        snapshot.save(oar);
+        oar.Flush();
+        // the archive is sealed by its index
+        CHECK_THROWS(oar(make_nvp("late", 1)));
+    }
+    std::string prefix(6, ' ');
+    ss.read(prefix.data(), prefix.size());
+    InArchive iar{BinaryDeserializer{ss, options}};
+    check_random_access(iar, snapshot);
+}
+
+TEST_CASE("binary-index", "[index][json]")
+{
+    Snapshot snapshot;
+    std::stringstream ss;
+    {
+        OutArchive oar{JsonSerializer{ss}};
+        snapshot.save(oar);
+        oar.Flush();
+    }
+    InArchive iar{JsonDeserializer{ss}};
+    check_random_access(iar, snapshot);
+}
+
+TEST_CASE("binary-index", "[index][chunks]")
+{
+    // elements sharing objects with earlier chunks cannot be read on their own
+    std::vector<std::shared_ptr<Node>> nodes;
+    for (int i = 0; i < 3000; ++i) {
+        nodes.push_back(std::make_shared<Node>());
+        nodes.back()->name = std::to_string(i);
+    }
+    nodes[2500]->next = nodes[10];
+
+    BinaryOptions options{.indexed = true};
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{buffer, options}};
+    oar(make_nvp("nodes", nodes));
+    oar.Flush();
+
+    InArchive iar{BufferBinaryDeserializer{buffer, options}};
+    std::vector<std::shared_ptr<Node>> loaded;
+    iar.LoadRange("nodes", 1500, 10, loaded);
+    REQUIRE(loaded.size() == 10);
+    CHECK(loaded[0]->name == "1500");
+    CHECK_THROWS(iar.LoadRange("nodes", 2100, 10, loaded));
+
+    std::vector<std::byte> plain;
+    OutArchive oar2{BufferBinarySerializer{plain}};
+    oar2(make_nvp("nodes", nodes));
+    oar2.Flush();
+    InArchive iar2{BufferBinaryDeserializer{plain}};
+    CHECK_THROWS(iar2.Seek("nodes"));
+}
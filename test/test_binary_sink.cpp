@@ -0,0 +1,75 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+
+using namespace zen;
+
+namespace
+{
+struct Sample {
+    std::string name{""};
+    int count{0};
+    std::vector<double> values;
+    std::map<std::string, int> table;
+
+    auto operator<=>(const Sample &other) const = default;
+
+    SERIALIZE_MEMBER(name, count, values, table)
+};
+
+Sample make_sample()
+{
+    Sample sample{.name = "sample", .count = 3};
+    for (int i = 0; i < 1000; ++i) {
+        sample.values.push_back(i * 0.5);
+        sample.table.emplace(std::to_string(i), i);
+    }
+    return sample;
+}
+
+Sample read_back(std::span<const std::byte> bytes)
+{
+    std::stringstream ss(
+        std::string(reinterpret_cast<const char *>(bytes.data()), bytes.size()));
+    Sample sample;
+    InArchive iar{BinaryDeserializer{ss}};
+    iar(make_nvp("sample", sample));
+    return sample;
+}
+} // namespace
+
+TEST_CASE("binary-sink", "[sink][buffer]")
+{
+    auto sample = make_sample();
+
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{buffer}};
+    oar(make_nvp("sample", sample));
+    oar.Flush();
+
+    std::stringstream ss;
+    OutArchive oar2{BinarySerializer{ss}};
+    oar2(make_nvp("sample", sample));
+    oar2.Flush();
+
+    auto str = ss.str();
+    REQUIRE(buffer.size() == str.size());
+    CHECK(std::memcmp(buffer.data(), str.data(), str.size()) == 0);
+    CHECK(read_back(buffer) == sample);
+}
+
+TEST_CASE("binary-sink", "[sink][span]")
+{
+    auto sample = make_sample();
+
+    std::vector<std::byte> storage(64 * 1024);
+    OutArchive oar{SpanBinarySerializer{std::span(storage)}};
+    oar(make_nvp("sample", sample));
+    oar.Flush();
+
+    // trailing bytes of the span are never consumed
+    CHECK(read_back(storage) == sample);
+
+    std::array<std::byte, 16> small;
+    OutArchive oar_small{SpanBinarySerializer{std::span<std::byte>(small)}};
+    CHECK_THROWS(oar_small(make_nvp("sample", sample)));
+}
@@ -0,0 +1,130 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+
+#include <complex>
+
+using namespace zen;
+
+namespace
+{
+struct Vec3 {
+    float x{0}, y{0}, z{0};
+
+    auto operator<=>(const Vec3 &other) const = default;
+
+    SERIALIZE_MEMBER(x, y, z)
+};
+
+struct Reordered {
+    float x{0}, y{0}, z{0};
+
+    auto operator<=>(const Reordered &other) const = default;
+
+    SERIALIZE_MEMBER(z, y, x)
+};
+
+struct Padded {
+    char c{0};
+    int i{0};
+
+    auto operator<=>(const Padded &other) const = default;
+
+    SERIALIZE_MEMBER(c, i)
+};
+
+struct Vertex {
+    Vec3 position;
+    std::array<float, 2> uv{};
+
+    auto operator<=>(const Vertex &other) const = default;
+
+    SERIALIZE_MEMBER(position, uv)
+};
+
+struct Opaque {
+    int a{0};
+    float b{0};
+
+    auto operator<=>(const Opaque &other) const = default;
+
+    SERIALIZE_MEMBER(a, b)
+};
+
+enum class Kind : std::uint16_t { A, B, C };
+
+template <typename T>
+void roundtrip(const T &value, BinaryOptions options = {})
+{
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{buffer, options}};
+    oar(make_nvp("value", value));
+    oar.Flush();
+
+    T value_out{};
+    InArchive iar{BufferBinaryDeserializer{buffer, options}};
+    iar(make_nvp("value", value_out));
+    CHECK(value_out == value);
+}
+} // namespace
+
+template <>
+struct zen::is_bitwise_serializable<Opaque> : std::true_type {};
+
+TEST_CASE("bitwise", "[bitwise][probe]")
+{
+    CHECK(IsBitwiseSerializable(Vec3{}));
+    CHECK(IsBitwiseSerializable(Vertex{}));
+    CHECK(IsBitwiseSerializable(std::complex<double>{}));
+    CHECK(IsBitwiseSerializable(std::array<std::array<float, 3>, 2>{}));
+    CHECK(IsBitwiseSerializable(Kind::A));
+    CHECK(IsBitwiseSerializable(std::byte{}));
+    CHECK(IsBitwiseSerializable(Opaque{}));
+    CHECK_FALSE(IsBitwiseSerializable(Reordered{}));
+    CHECK_FALSE(IsBitwiseSerializable(Padded{}));
+}
+
+TEST_CASE("bitwise", "[bitwise][binary]")
+{
+    std::vector<Vec3> points;
+    std::vector<Vertex> vertices;
+    std::vector<std::complex<double>> complexes;
+    std::vector<Kind> kinds;
+    std::vector<std::byte> bytes;
+    std::vector<Reordered> reordered;
+    std::vector<Padded> padded;
+    std::array<std::array<float, 3>, 4> matrix{};
+    for (int i = 0; i < 100; ++i) {
+        float f = static_cast<float>(i);
+        points.push_back({f, f + 1, f + 2});
+        vertices.push_back({{f, f, f}, {f, -f}});
+        complexes.emplace_back(f, -f);
+        kinds.push_back(static_cast<Kind>(i % 3));
+        bytes.push_back(static_cast<std::byte>(i));
+        reordered.push_back({f, f + 1, f + 2});
+        padded.push_back({static_cast<char>(i), i});
+    }
+    matrix[1][2] = 5;
+
+    roundtrip(points);
+    roundtrip(vertices);
+    roundtrip(complexes);
+    roundtrip(kinds);
+    roundtrip(bytes);
+    roundtrip(reordered);
+    roundtrip(padded);
+    roundtrip(matrix);
+    roundtrip(kinds, {.compact = true});
+    roundtrip(points, {.compact = true});
+
+    // bulk copies produce exactly the element-wise encoding
+    std::vector<std::byte> bulk, elementwise;
+    OutArchive oar{BufferBinarySerializer{bulk}};
+    oar(make_nvp("value", points));
+    oar.Flush();
+    OutArchive oar2{BufferBinarySerializer{elementwise}};
+    oar2(make_nvp("value", reordered));
+    oar2.Flush();
+    CHECK(bulk.size() == sizeof(std::uint64_t) + points.size() * sizeof(Vec3));
+    CHECK(bulk.size() == elementwise.size());
+    CHECK(std::memcmp(bulk.data() + 8, points.data(), sizeof(Vec3)) == 0);
+}
@@ -0,0 +1,80 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+
+using namespace zen;
+
+namespace
+{
+struct Payload {
+    std::vector<int> numbers;
+    std::string name;
+    std::vector<std::byte> blob;
+
+    SERIALIZE_MEMBER(numbers, name, blob)
+};
+
+struct PayloadView {
+    std::span<const int> numbers;
+    std::string_view name;
+    BorrowedBlob blob;
+
+    SERIALIZE_MEMBER(numbers, name, blob)
+};
+} // namespace
+
+TEST_CASE("borrowed", "[borrowed][binary]")
+{
+    Payload payload{.numbers = {1, 2, 3, 4, 5}, .name = "borrowed payload"};
+    for (int i = 0; i < 64; ++i) {
+        payload.blob.push_back(static_cast<std::byte>(i));
+    }
+
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{buffer}};
+    oar(make_nvp("payload", payload));
+    oar.Flush();
+
+    PayloadView view;
+    {
+        InArchive iar{BufferBinaryDeserializer{buffer}};
+        iar(make_nvp("payload", view));
+    }
+
+    auto in_buffer = [&](const void *ptr) {
+        auto p = static_cast<const std::byte *>(ptr);
+        return p >= buffer.data() && p < buffer.data() + buffer.size();
+    };
+
+    CHECK(std::ranges::equal(view.numbers, payload.numbers));
+    CHECK(view.name == payload.name);
+    CHECK(std::ranges::equal(view.blob.bytes, payload.blob));
+    CHECK(in_buffer(view.numbers.data()));
+    CHECK(in_buffer(view.name.data()));
+    CHECK(in_buffer(view.blob.bytes.data()));
+
+    // borrowed views serialize back to the owning representation
+    std::vector<std::byte> buffer2;
+    OutArchive oar2{BufferBinarySerializer{buffer2}};
+    oar2(make_nvp("payload", view));
+    oar2.Flush();
+    CHECK(buffer2 == buffer);
+
+    std::stringstream ss(std::string(
+        reinterpret_cast<const char *>(buffer.data()), buffer.size()));
+    InArchive iar_stream{BinaryDeserializer{ss}};
+    CHECK_THROWS(iar_stream(make_nvp("payload", view)));
+}
+
+TEST_CASE("borrowed", "[borrowed][json]")
+{
+    std::string name = "borrowed from json";
+    std::stringstream ss;
+    OutArchive oar{JsonSerializer{ss}};
+    oar(make_nvp("name", name));
+    oar.Flush();
+
+    InArchive iar{JsonDeserializer{ss}};
+    std::string_view view;
+    iar(make_nvp("name", view));
+    CHECK(view == name);
+}
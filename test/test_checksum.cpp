@@ -0,0 +1,146 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+
+#include <sstream>
+
+using namespace zen;
+
+namespace
+{
+struct Record {
+    std::string name;
+    std::vector<std::int64_t> values;
+    std::vector<float> weights;
+
+    SERIALIZE_MEMBER(name, values, weights)
+};
+
+std::vector<Record> make_records()
+{
+    std::vector<Record> records(50);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i].name = "record_" + std::to_string(i);
+        records[i].values.assign(i * 10, static_cast<std::int64_t>(i) - 7);
+        records[i].weights.assign(300, i * 0.25f);
+    }
+    return records;
+}
+
+bool same(const std::vector<Record> &a, const std::vector<Record> &b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].name != b[i].name || a[i].values != b[i].values ||
+            a[i].weights != b[i].weights) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr ChecksumVerify modes[] = {ChecksumVerify::Eager,
+                                    ChecksumVerify::Lazy, ChecksumVerify::Off};
+} // namespace
+
+TEST_CASE("checksum", "[checksum][crc32c]")
+{
+    CHECK(detail::Crc32c("123456789", 9) == 0xE3069283);
+    CHECK(detail::Crc32cScalar("123456789", 9) == 0xE3069283);
+    CHECK(detail::Crc32c("", 0) == 0);
+
+    std::vector<std::uint8_t> data(100'000);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<std::uint8_t>(i * 31 + (i >> 7));
+    }
+    // sizes around the interleaved block boundaries and unaligned starts
+    for (std::size_t size :
+         {1, 7, 8, 767, 768, 769, 24575, 24576, 24577, 99'000}) {
+        for (std::size_t offset : {0, 3}) {
+            CHECK(detail::Crc32c(data.data() + offset, size) ==
+                  detail::Crc32cScalar(data.data() + offset, size));
+        }
+    }
+    auto head = detail::Crc32c(data.data(), 1000);
+    CHECK(detail::Crc32c(data.data() + 1000, 50'000, head) ==
+          detail::Crc32c(data.data(), 51'000));
+}
+
+TEST_CASE("checksum", "[checksum][roundtrip]")
+{
+    auto records = make_records();
+    ChecksumOptions options{.chunk_size = 1000};
+
+    std::vector<std::byte> buffer;
+    {
+        OutArchive oar{BufferChecksummedBinarySerializer{
+            ChecksumSink<BufferSink>{buffer, options}}};
+        oar(make_nvp("records", records));
+        oar.Flush();
+    }
+    std::stringstream ss;
+    {
+        OutArchive oar{
+            ChecksummedBinarySerializer{ChecksumSink<StreamSink>{ss, options}}};
+        oar(make_nvp("records", records));
+    }
+    CHECK(ss.str().size() == buffer.size());
+
+    for (auto verify : modes) {
+        std::vector<Record> from_buffer;
+        InArchive iar{BufferChecksummedBinaryDeserializer{
+            ChecksumSource<SpanSource>{buffer, {.verify = verify}}}};
+        iar(make_nvp("records", from_buffer));
+        CHECK(same(from_buffer, records));
+
+        std::vector<Record> from_stream;
+        std::stringstream is(ss.str());
+        InArchive iar2{ChecksummedBinaryDeserializer{
+            ChecksumSource<StreamSource>{is, {.verify = verify}}}};
+        iar2(make_nvp("records", from_stream));
+        CHECK(same(from_stream, records));
+    }
+}
+
+TEST_CASE("checksum", "[checksum][corruption]")
+{
+    auto records = make_records();
+    std::vector<std::byte> buffer;
+    {
+        OutArchive oar{BufferChecksummedBinarySerializer{
+            ChecksumSink<BufferSink>{buffer, {.chunk_size = 4096}}}};
+        oar(make_nvp("records", records));
+        oar.Flush();
+    }
+    // a flipped bit in the middle of a weight
+    auto corrupted = buffer;
+    corrupted[corrupted.size() / 2] ^= std::byte{0x10};
+
+    for (auto verify : {ChecksumVerify::Eager, ChecksumVerify::Lazy}) {
+        std::vector<Record> out;
+        InArchive iar{BufferChecksummedBinaryDeserializer{
+            ChecksumSource<SpanSource>{corrupted, {.verify = verify}}}};
+        CHECK_THROWS(iar(make_nvp("records", out)));
+
+        auto chars = reinterpret_cast<const char *>(corrupted.data());
+        std::stringstream is(std::string(chars, corrupted.size()));
+        InArchive iar2{ChecksummedBinaryDeserializer{
+            ChecksumSource<StreamSource>{is, {.verify = verify}}}};
+        CHECK_THROWS(iar2(make_nvp("records", out)));
+    }
+
+    // without verification the flipped bit goes unnoticed
+    std::vector<Record> out;
+    ChecksumOptions off{.verify = ChecksumVerify::Off};
+    InArchive iar{BufferChecksummedBinaryDeserializer{
+        ChecksumSource<SpanSource>{corrupted, off}}};
+    iar(make_nvp("records", out));
+    CHECK_FALSE(same(out, records));
+
+    // truncated archives fail with a short read
+    std::span<const std::byte> truncated(buffer.data(), buffer.size() - 10);
+    InArchive iar2{BufferChecksummedBinaryDeserializer{
+        ChecksumSource<SpanSource>{truncated}}};
+    CHECK_THROWS(iar2(make_nvp("records", out)));
+}
@@ -0,0 +1,128 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+
+using namespace zen;
+
+namespace
+{
+enum class Color : std::int32_t { Red = -1, Green = 1, Blue = 300 };
+
+struct Record {
+    std::int64_t id{0};
+    std::int16_t delta{0};
+    std::uint32_t flags{0};
+    Color color{Color::Red};
+    double value{0};
+    std::string name;
+    std::vector<std::int32_t> samples;
+    std::vector<std::uint64_t> offsets;
+    std::variant<int, std::string> tag;
+    std::shared_ptr<int> shared;
+
+    SERIALIZE_MEMBER(id, delta, flags, color, value, name, samples, offsets,
+                     tag, shared)
+};
+
+Record make_record()
+{
+    Record record{.id = -1234567890123,
+                  .delta = -7,
+                  .flags = 0xFFFFFFFF,
+                  .color = Color::Blue,
+                  .value = 3.5,
+                  .name = "compact",
+                  .tag = "tag",
+                  .shared = std::make_shared<int>(42)};
+    // mostly single byte values with a few wide ones in between, so both the
+    // SIMD fast path and the scalar fallback are exercised
+    for (int i = 0; i < 200; ++i) {
+        record.samples.push_back(i % 37 == 0 ? -100000 * i : i % 60 - 30);
+        record.offsets.push_back(i % 50 == 0 ? std::uint64_t{1} << (i % 64)
+                                             : i % 100);
+    }
+    return record;
+}
+
+void check_record(const Record &a, const Record &b)
+{
+    CHECK(a.id == b.id);
+    CHECK(a.delta == b.delta);
+    CHECK(a.flags == b.flags);
+    CHECK(a.color == b.color);
+    CHECK(a.value == b.value);
+    CHECK(a.name == b.name);
+    CHECK(a.samples == b.samples);
+    CHECK(a.offsets == b.offsets);
+    CHECK(a.tag == b.tag);
+    REQUIRE(b.shared);
+    CHECK(*a.shared == *b.shared);
+}
+} // namespace
+
+TEST_CASE("compact-binary", "[compact][buffer]")
+{
+    auto record = make_record();
+    BinaryOptions options{.compact = true};
+
+    std::vector<std::byte> compact, fixed;
+    OutArchive oar{BufferBinarySerializer{compact, options}};
+    oar(make_nvp("record", record));
+    oar.Flush();
+
+    OutArchive oar_fixed{BufferBinarySerializer{fixed}};
+    oar_fixed(make_nvp("record", record));
+    oar_fixed.Flush();
+
+    CHECK(compact.size() < fixed.size() / 2);
+
+    Record record_out;
+    InArchive iar{BufferBinaryDeserializer{compact, options}};
+    iar(make_nvp("record", record_out));
+    check_record(record, record_out);
+
+    InArchive iar_plain{BufferBinaryDeserializer{compact}};
+    Record record_bad;
+    CHECK_THROWS(iar_plain(make_nvp("record", record_bad)));
+    CHECK_THROWS(InArchive{BufferBinaryDeserializer{fixed, options}});
+}
+
+TEST_CASE("compact-binary", "[compact][stream]")
+{
+    auto record = make_record();
+    BinaryOptions options{.compact = true};
+
+    std::stringstream ss;
+    OutArchive oar{BinarySerializer{ss, options}};
+    oar(make_nvp("record", record));
+    oar.Flush();
+
+    Record record_out;
+    InArchive iar{BinaryDeserializer{ss, options}};
+    iar(make_nvp("record", record_out));
+    check_record(record, record_out);
+}
+
+TEST_CASE("varint", "[compact][varint]")
+{
+    std::vector<std::int64_t> values;
+    for (int shift = 0; shift < 63; ++shift) {
+        values.push_back(std::int64_t{1} << shift);
+        values.push_back(-(std::int64_t{1} << shift));
+    }
+    values.push_back(std::numeric_limits<std::int64_t>::min());
+    values.push_back(std::numeric_limits<std::int64_t>::max());
+
+    std::vector<std::byte> bytes(values.size() * detail::MaxVarintSize);
+    std::size_t n = 0;
+    for (auto v : values) {
+        auto encoded = detail::ZigZagEncode(v);
+        auto size = detail::EncodeVarint(encoded, bytes.data() + n);
+        CHECK(size == detail::VarintSize(encoded));
+        n += size;
+    }
+
+    std::vector<std::int64_t> decoded(values.size());
+    CHECK(detail::DecodeVarints(std::span(bytes).first(n),
+                                std::span(decoded)) == n);
+    CHECK(decoded == values);
+}
@@ -0,0 +1,136 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+
+#include <optional>
+#include <sstream>
+
+using namespace zen;
+
+namespace
+{
+struct Frame {
+    std::string name;
+    std::vector<std::int32_t> values;
+    std::vector<double> samples;
+
+    SERIALIZE_MEMBER(name, values, samples)
+};
+
+std::vector<Frame> make_frames(int count)
+{
+    std::vector<Frame> frames(count);
+    for (int i = 0; i < count; ++i) {
+        frames[i].name = "frame_" + std::to_string(i);
+        for (int j = 0; j < 500; ++j) {
+            frames[i].values.push_back((i + j) % 17);
+            frames[i].samples.push_back(j * 0.5);
+        }
+    }
+    return frames;
+}
+
+std::vector<Codec> codecs()
+{
+    std::vector<Codec> result{Codec::None};
+    if (detail::HasCodec(Codec::Zstd)) {
+        result.push_back(Codec::Zstd);
+    }
+    return result;
+}
+
+bool same(const std::vector<Frame> &a, const std::vector<Frame> &b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].name != b[i].name || a[i].values != b[i].values ||
+            a[i].samples != b[i].samples) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("compression", "[compression][roundtrip]")
+{
+    auto frames = make_frames(64);
+    ThreadPool pool(3);
+    for (auto codec : codecs()) {
+        CompressionOptions options{.codec = codec,
+                                   .block_size = 4096,
+                                   .max_in_flight = 4,
+                                   .pool = &pool};
+        std::stringstream ss;
+        {
+            OutArchive oar{CompressedBinarySerializer{
+                CompressingSink<StreamSink>{ss, options}}};
+            oar(make_nvp("frames", frames));
+        }
+        if (codec == Codec::Zstd) {
+            std::stringstream plain;
+            {
+                OutArchive oar{BinarySerializer{plain}};
+                oar(make_nvp("frames", frames));
+            }
+            CHECK(ss.str().size() * 4 < plain.str().size());
+        }
+
+        std::vector<Frame> frames_out;
+        InArchive iar{CompressedBinaryDeserializer{
+            DecompressingSource<StreamSource>{ss, options}}};
+        iar(make_nvp("frames", frames_out));
+        CHECK(same(frames_out, frames));
+    }
+}
+
+TEST_CASE("compression", "[compression][segments]")
+{
+    // every Flush() ends a segment the reader can consume on its own, and
+    // reading continues across segment ends
+    auto frames = make_frames(8);
+    CompressionOptions options{.block_size = 1000};
+    std::stringstream ss;
+    OutArchive oar{CompressedBinarySerializer{
+        CompressingSink<StreamSink>{ss, options},
+        BinaryOptions{.compact = true}}};
+    std::optional<InArchive> iar;
+    for (int round = 0; round < 3; ++round) {
+        oar(make_nvp("frames", frames));
+        oar.Flush();
+        oar.Flush();
+
+        if (!iar) {
+            iar.emplace(CompressedBinaryDeserializer{
+                DecompressingSource<StreamSource>{ss, options},
+                BinaryOptions{.compact = true}});
+        }
+        std::vector<Frame> frames_out;
+        (*iar)(make_nvp("frames", frames_out));
+        CHECK(same(frames_out, frames));
+    }
+}
+
+TEST_CASE("compression", "[compression][frames]")
+{
+    std::vector<std::byte> raw(10000);
+    for (std::size_t i = 0; i < raw.size(); ++i) {
+        raw[i] = static_cast<std::byte>(i % 251);
+    }
+    for (auto codec : codecs()) {
+        auto frame = detail::EncodeFrame(codec, 3, raw);
+        auto [stored, size] = detail::LoadFrameHeader(frame.data());
+        CHECK(size == raw.size());
+        REQUIRE(stored + detail::FrameHeaderSize == frame.size());
+        auto decoded = detail::DecodeFrame(
+            codec, std::span(frame).subspan(detail::FrameHeaderSize), size);
+        CHECK(decoded == raw);
+        CHECK_THROWS(detail::DecodeFrame(
+            codec, std::span(frame).subspan(detail::FrameHeaderSize),
+            size + 1));
+    }
+
+    std::stringstream ss("not compressed");
+    CHECK_THROWS(DecompressingSource<StreamSource>{ss});
+}
@@ -0,0 +1,199 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+#include <zen_serialization/size_archive.h>
+
+#include <sstream>
+
+using namespace zen;
+
+namespace
+{
+struct Node {
+    std::string name;
+    std::shared_ptr<Node> next;
+
+    SERIALIZE_MEMBER(name, next)
+};
+
+struct Thumbnail {
+    std::int32_t width{0};
+    std::int32_t height{0};
+    std::vector<std::uint8_t> pixels;
+
+    bool operator==(const Thumbnail &) const = default;
+
+    SERIALIZE_MEMBER(width, height, pixels)
+};
+
+struct Scene {
+    std::string name;
+    Lazy<Thumbnail> thumbnail;
+    Lazy<std::vector<std::string>> history;
+    std::shared_ptr<Node> root;
+    /// refers to root, written before it
+    Lazy<std::shared_ptr<Node>> lazy_root;
+    /// first written inside the payload, referenced again afterwards
+    Lazy<std::shared_ptr<Node>> lazy_leaf;
+    std::shared_ptr<Node> leaf;
+    Lazy<Lazy<std::int32_t>> nested;
+    std::int32_t after{0};
+
+    SERIALIZE_MEMBER(name, thumbnail, history, root, lazy_root, lazy_leaf,
+                     leaf, nested, after)
+};
+
+Scene make_scene()
+{
+    Scene scene;
+    scene.name = "scene";
+    Thumbnail thumbnail{4, 3, {}};
+    for (int i = 0; i < 12; ++i) {
+        thumbnail.pixels.push_back(static_cast<std::uint8_t>(i * 20));
+    }
+    scene.thumbnail = thumbnail;
+    scene.history = std::vector<std::string>{"create", "move", "rename"};
+    scene.root = std::make_shared<Node>(Node{"root", nullptr});
+    scene.lazy_root = scene.root;
+    auto leaf = std::make_shared<Node>(Node{"leaf", scene.root});
+    scene.lazy_leaf = leaf;
+    scene.leaf = leaf;
+    scene.nested = Lazy<std::int32_t>(42);
+    scene.after = 7;
+    return scene;
+}
+
+void check_deferred(Scene &loaded, const Scene &scene)
+{
+    CHECK(loaded.name == scene.name);
+    CHECK(loaded.after == scene.after);
+    CHECK_FALSE(loaded.thumbnail.IsLoaded());
+    CHECK_FALSE(loaded.history.IsLoaded());
+    CHECK_FALSE(loaded.nested.IsLoaded());
+
+    CHECK(loaded.thumbnail.get() == scene.thumbnail.get());
+    CHECK(loaded.thumbnail.IsLoaded());
+    CHECK(loaded.history.get() == scene.history.get());
+    CHECK(loaded.nested.get().get() == 42);
+
+    // refers to an object written before the payload: shared
+    CHECK(loaded.lazy_root.get() == loaded.root);
+    // first written inside the payload: the outside reference has a copy
+    REQUIRE(loaded.leaf);
+    REQUIRE(loaded.lazy_leaf.get());
+    CHECK(loaded.leaf->name == "leaf");
+    CHECK(loaded.lazy_leaf.get()->name == "leaf");
+    CHECK(loaded.leaf->next == loaded.root);
+    CHECK(loaded.lazy_leaf.get()->next == loaded.root);
+}
+} // namespace
+
+TEST_CASE("lazy members are decoded on first access", "[lazy]")
+{
+    auto scene = make_scene();
+    for (auto options : {BinaryOptions{}, BinaryOptions{.compact = true},
+                         BinaryOptions{.portable = true}}) {
+        std::vector<std::byte> buffer;
+        {
+            OutArchive oar{BufferBinarySerializer{buffer, options}};
+            oar(make_nvp("scene", scene));
+            oar.Flush();
+        }
+        InArchive iar{BufferBinaryDeserializer{buffer, options}};
+        Scene loaded;
+        iar(make_nvp("scene", loaded));
+        check_deferred(loaded, scene);
+    }
+}
+
+TEST_CASE("lazy members from a stream", "[lazy]")
+{
+    auto scene = make_scene();
+    std::stringstream ss;
+    {
+        OutArchive oar{BinarySerializer{ss}};
+        oar(make_nvp("scene", scene), make_nvp("tail", 99));
+    }
+    InArchive iar{BinaryDeserializer{ss}};
+    Scene loaded;
+    int tail = 0;
+    iar(make_nvp("scene", loaded));
+    // decoding in between must not disturb the read position
+    check_deferred(loaded, scene);
+    iar(make_nvp("tail", tail));
+    CHECK(tail == 99);
+}
+
+TEST_CASE("lazy members in json", "[lazy]")
+{
+    auto scene = make_scene();
+    std::stringstream ss;
+    {
+        OutArchive oar{JsonSerializer{ss}};
+        oar(make_nvp("scene", scene));
+        oar.Flush();
+    }
+    InArchive iar{JsonDeserializer{ss}};
+    Scene loaded;
+    iar(make_nvp("scene", loaded));
+    check_deferred(loaded, scene);
+
+    std::vector<Lazy<std::string>> names(3);
+    names[1] = std::string("one");
+    std::stringstream ss2;
+    {
+        OutArchive oar{JsonSerializer{ss2}};
+        oar(make_nvp("names", names));
+        oar.Flush();
+    }
+    InArchive iar2{JsonDeserializer{ss2}};
+    std::vector<Lazy<std::string>> loaded_names;
+    iar2(make_nvp("names", loaded_names));
+    REQUIRE(loaded_names.size() == 3);
+    CHECK(loaded_names[1].get() == "one");
+    CHECK(loaded_names[2].get().empty());
+}
+
+TEST_CASE("lazy members of sources that cannot seek load eagerly", "[lazy]")
+{
+    auto scene = make_scene();
+    std::stringstream ss;
+    {
+        OutArchive oar{
+            ChecksummedBinarySerializer{ChecksumSink<StreamSink>{ss, {}}}};
+        oar(make_nvp("scene", scene));
+        oar.Flush();
+    }
+    InArchive iar{
+        ChecksummedBinaryDeserializer{ChecksumSource<StreamSource>{ss, {}}}};
+    Scene loaded;
+    iar(make_nvp("scene", loaded));
+    CHECK(loaded.thumbnail.IsLoaded());
+    CHECK(loaded.thumbnail.get() == scene.thumbnail.get());
+    CHECK(loaded.lazy_root.get() == loaded.root);
+    CHECK(loaded.leaf->next == loaded.root);
+    CHECK(loaded.after == scene.after);
+}
+
+TEST_CASE("lazy members are resaved and sized", "[lazy]")
+{
+    auto scene = make_scene();
+    std::vector<std::byte> first, second;
+    {
+        OutArchive oar{BufferBinarySerializer{first}};
+        oar(make_nvp("scene", scene));
+        oar.Flush();
+    }
+    InArchive iar{BufferBinaryDeserializer{first}};
+    Scene loaded;
+    iar(make_nvp("scene", loaded));
+    {
+        // untouched members are decoded to be written again
+        OutArchive oar{BufferBinarySerializer{second}};
+        oar(make_nvp("scene", loaded));
+        oar.Flush();
+    }
+    CHECK(second.size() == first.size());
+    SizeArchive sizer;
+    sizer(make_nvp("scene", scene));
+    CHECK(sizer.Size() == first.size());
+}
@@ -0,0 +1,51 @@
+#include <catch.hpp>
+#include <zen_serialization/mapped_archive.h>
+
+using namespace zen;
+
+namespace
+{
+struct Snapshot {
+    std::string header;
+    std::vector<double> samples;
+    std::map<std::string, int> metadata;
+
+    auto operator<=>(const Snapshot &other) const = default;
+
+    SERIALIZE_MEMBER(header, samples, metadata)
+};
+} // namespace
+
+TEST_CASE("mapped-archive", "[mapped]")
+{
+    auto path = std::filesystem::temp_directory_path() / "zen_mapped_test.bin";
+
+    Snapshot snapshot{.header = "snapshot"};
+    for (int i = 0; i < 10000; ++i) {
+        snapshot.samples.push_back(i * 0.25);
+    }
+    snapshot.metadata = {{"one", 1}, {"two", 2}};
+
+    {
+        // start tiny so the mapping has to grow several times
+        MappedOutArchive oar{path, 64};
+        oar(make_nvp("snapshot", snapshot));
+        oar.Flush();
+    }
+
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{buffer}};
+    oar(make_nvp("snapshot", snapshot));
+    oar.Flush();
+    CHECK(std::filesystem::file_size(path) == buffer.size());
+
+    {
+        Snapshot snapshot_out;
+        MappedInArchive iar{path};
+        CHECK(std::ranges::equal(iar.Bytes(), buffer));
+        iar(make_nvp("snapshot", snapshot_out));
+        CHECK(snapshot_out == snapshot);
+    }
+
+    std::filesystem::remove(path);
+}
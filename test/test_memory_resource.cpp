@@ -0,0 +1,227 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+
+#include <memory_resource>
+#include <sstream>
+
+using namespace zen;
+
+namespace
+{
+/// counts the blocks handed out and not returned yet
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations{0};
+    std::size_t live{0};
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        ++live;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *ptr, std::size_t bytes,
+                       std::size_t alignment) override
+    {
+        --live;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+struct Part {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    Part() = default;
+    explicit Part(const allocator_type &allocator)
+        : name(allocator), tags(allocator), counts(allocator)
+    {
+    }
+
+    std::pmr::string name;
+    std::pmr::vector<std::pmr::string> tags;
+    std::pmr::map<std::pmr::string, std::int32_t> counts;
+    std::shared_ptr<Part> next;
+
+    SERIALIZE_MEMBER(name, tags, counts, next)
+};
+
+struct Gadget {
+    virtual ~Gadget() = default;
+    std::int32_t id{0};
+
+    SERIALIZE_MEMBER(id)
+};
+
+struct Widget : Gadget {
+    std::string label;
+    std::unique_ptr<Part> spare;
+
+    SERIALIZE_MEMBER(BaseClass<Gadget>(this), label, spare)
+};
+
+/// long enough to never fit in the small string buffer
+std::string long_text(int i)
+{
+    return fmt::format("a string long enough to be allocated {:04}", i);
+}
+
+std::pmr::string long_pmr_text(int i) { return std::pmr::string(long_text(i)); }
+
+std::vector<std::shared_ptr<Part>> make_parts(int n)
+{
+    std::vector<std::shared_ptr<Part>> parts;
+    for (int i = 0; i < n; ++i) {
+        auto part = std::make_shared<Part>();
+        part->name = long_text(i);
+        part->tags = {long_pmr_text(i + 1), long_pmr_text(i + 2)};
+        part->counts = {{long_pmr_text(i), i}, {long_pmr_text(-i), -i}};
+        if (!parts.empty()) {
+            part->next = parts.back();
+        }
+        parts.push_back(part);
+    }
+    return parts;
+}
+
+void check_parts(const std::vector<std::shared_ptr<Part>> &loaded, int n)
+{
+    REQUIRE(loaded.size() == static_cast<std::size_t>(n));
+    auto parts = make_parts(n);
+    for (int i = 0; i < n; ++i) {
+        CHECK(loaded[i]->name == parts[i]->name);
+        CHECK(loaded[i]->tags == parts[i]->tags);
+        CHECK(loaded[i]->counts == parts[i]->counts);
+        if (i > 0) {
+            CHECK(loaded[i]->next == loaded[i - 1]);
+        }
+    }
+}
+
+bool inside(const void *ptr, const std::vector<std::byte> &arena)
+{
+    auto address = static_cast<const std::byte *>(ptr);
+    return address >= arena.data() && address < arena.data() + arena.size();
+}
+} // namespace
+
+REGISTER_CLASS(Gadget)
+REGISTER_CLASS(Widget)
+
+TEST_CASE("memory-resource", "[pmr][arena]")
+{
+    constexpr int n = 50;
+    auto parts = make_parts(n);
+    std::vector<std::byte> buffer;
+    {
+        OutArchive oar{BufferBinarySerializer{buffer}};
+        oar(make_nvp("parts", parts));
+        oar.Flush();
+    }
+    std::stringstream ss;
+    {
+        OutArchive oar{JsonSerializer{ss}};
+        oar(make_nvp("parts", parts));
+    }
+
+    for (bool json : {false, true}) {
+        // an arena without upstream, allocations outside it would throw
+        std::vector<std::byte> arena(1 << 20);
+        std::pmr::monotonic_buffer_resource resource(
+            arena.data(), arena.size(), std::pmr::null_memory_resource());
+        std::vector<std::shared_ptr<Part>> loaded;
+        if (json) {
+            std::stringstream copy(ss.str());
+            InArchive iar{JsonDeserializer{copy}};
+            iar.SetMemoryResource(&resource);
+            iar(make_nvp("parts", loaded));
+        } else {
+            InArchive iar{BufferBinaryDeserializer{buffer}};
+            iar.SetMemoryResource(&resource);
+            CHECK(iar.GetMemoryResource() == &resource);
+            iar(make_nvp("parts", loaded));
+        }
+        check_parts(loaded, n);
+        for (const auto &part : loaded) {
+            CHECK(inside(part.get(), arena));
+            CHECK(inside(part->name.data(), arena));
+            CHECK(inside(part->tags[1].data(), arena));
+            CHECK(inside(part->counts.begin()->first.data(), arena));
+        }
+        // objects are laid out in the order they were read
+        CHECK(loaded[0].get() < loaded[1].get());
+        CHECK(loaded[1].get() < loaded[n - 1].get());
+        loaded.clear();
+    }
+}
+
+TEST_CASE("memory-resource", "[pmr][polymorphic]")
+{
+    std::vector<std::shared_ptr<Gadget>> gadgets;
+    for (int i = 0; i < 10; ++i) {
+        auto widget = std::make_shared<Widget>();
+        widget->id = i;
+        widget->label = long_text(i);
+        widget->spare = std::make_unique<Part>();
+        widget->spare->name = long_text(-i);
+        gadgets.push_back(widget);
+        gadgets.push_back(widget);
+    }
+    std::vector<std::byte> buffer;
+    {
+        OutArchive oar{BufferBinarySerializer{buffer}};
+        oar(make_nvp("gadgets", gadgets));
+        oar.Flush();
+    }
+
+    CountingResource resource;
+    {
+        InArchive iar{BufferBinaryDeserializer{buffer}};
+        iar.SetMemoryResource(&resource);
+        std::vector<std::shared_ptr<Gadget>> loaded;
+        iar(make_nvp("gadgets", loaded));
+        REQUIRE(loaded.size() == gadgets.size());
+        for (std::size_t i = 0; i < loaded.size(); i += 2) {
+            auto widget = std::dynamic_pointer_cast<Widget>(loaded[i]);
+            REQUIRE(widget);
+            CHECK(widget->id == static_cast<std::int32_t>(i / 2));
+            CHECK(widget->label == long_text(widget->id));
+            REQUIRE(widget->spare);
+            CHECK(widget->spare->name == long_pmr_text(-widget->id));
+            CHECK(loaded[i + 1] == loaded[i]);
+        }
+        // the 10 widgets and their control blocks; the unique_ptr parts are
+        // deleted by their owners and come from the heap
+        CHECK(resource.allocations == 20);
+        CHECK(resource.live == resource.allocations);
+    }
+    // destroyed and returned to the resource with the last owner
+    CHECK(resource.live == 0);
+}
+
+TEST_CASE("memory-resource", "[pmr][string]")
+{
+    auto text = long_pmr_text(1);
+    std::pmr::vector<std::pmr::string> texts{long_pmr_text(2),
+                                             long_pmr_text(3)};
+    std::stringstream ss;
+    {
+        OutArchive oar{BinarySerializer{ss}};
+        oar(make_nvp("text", text), make_nvp("texts", texts));
+    }
+    // written like std::string
+    InArchive iar{BinaryDeserializer{ss}};
+    std::string loaded;
+    std::vector<std::string> loaded_texts;
+    iar(make_nvp("text", loaded), make_nvp("texts", loaded_texts));
+    CHECK(loaded == std::string_view(text));
+    REQUIRE(loaded_texts.size() == 2);
+    CHECK(loaded_texts[1] == std::string_view(texts[1]));
+}
@@ -0,0 +1,168 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+
+#include <cstring>
+
+using namespace zen;
+
+namespace
+{
+struct Vec3 {
+    float x{0}, y{0}, z{0};
+
+    auto operator<=>(const Vec3 &other) const = default;
+
+    SERIALIZE_MEMBER(x, y, z)
+};
+
+struct Wide {
+    long l{0};
+    unsigned long ul{0};
+    wchar_t wc{0};
+    long double ld{0};
+    std::vector<long> longs;
+    std::vector<long double> long_doubles;
+
+    SERIALIZE_MEMBER(l, ul, wc, ld, longs, long_doubles)
+};
+
+/// writes values in the byte order opposite to the host's, as an archive from
+/// a host of the other endianness would contain
+class ForeignWriter
+{
+public:
+    std::vector<std::byte> bytes;
+
+    ForeignWriter()
+    {
+        for (auto c : BinaryHeader::Magic) {
+            bytes.push_back(static_cast<std::byte>(c));
+        }
+        bytes.push_back(std::byte{BinaryHeader::Version});
+        auto flags = BinaryOptions{.portable = true}.Flags();
+        if (!BinaryOptions::NativeBigEndian) {
+            flags |= BinaryOptions::BigEndianFlag;
+        }
+        bytes.push_back(std::byte{flags});
+    }
+
+    template <typename T>
+    void write(T value)
+    {
+        value = detail::ByteSwap(value);
+        auto offset = bytes.size();
+        bytes.resize(offset + sizeof(T));
+        std::memcpy(bytes.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    void write(const std::vector<T> &values)
+    {
+        write(static_cast<std::uint64_t>(values.size()));
+        for (const auto &v : values) {
+            write(v);
+        }
+    }
+};
+} // namespace
+
+TEST_CASE("portable-binary", "[portable][buffer]")
+{
+    Wide wide{.l = -1234567,
+              .ul = 7654321,
+              .wc = L'é',
+              .ld = 1.25L,
+              .longs = {-1, 0, 1, 1 << 30},
+              .long_doubles = {0.5L, -2.0L}};
+    std::vector<Vec3> points{{1, 2, 3}, {4, 5, 6}};
+    BinaryOptions options{.portable = true};
+
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{buffer, options}};
+    oar(make_nvp("wide", wide), make_nvp("points", points));
+    oar.Flush();
+
+    // header + 8 + 8 + 4 + 8 + (8 + 4 * 8) + (8 + 2 * 8) + (8 + 2 * 12)
+    CHECK(buffer.size() == 6 + 8 + 8 + 4 + 8 + 40 + 24 + 32);
+
+    Wide wide_out;
+    std::vector<Vec3> points_out;
+    InArchive iar{BufferBinaryDeserializer{buffer, options}};
+    iar(make_nvp("wide", wide_out), make_nvp("points", points_out));
+    CHECK(wide_out.l == wide.l);
+    CHECK(wide_out.ul == wide.ul);
+    CHECK(wide_out.wc == wide.wc);
+    CHECK(wide_out.ld == wide.ld);
+    CHECK(wide_out.longs == wide.longs);
+    CHECK(wide_out.long_doubles == wide.long_doubles);
+    CHECK(points_out == points);
+
+    CHECK_THROWS(InArchive{BufferBinaryDeserializer{
+        buffer, BinaryOptions{.compact = true, .portable = true}}});
+}
+
+TEST_CASE("portable-binary", "[portable][foreign]")
+{
+    std::vector<std::uint32_t> u32(100);
+    std::vector<std::int16_t> i16(37);
+    std::vector<double> f64(13);
+    for (std::size_t i = 0; i < u32.size(); ++i) {
+        u32[i] = static_cast<std::uint32_t>(i * 0x01020304u);
+    }
+    for (std::size_t i = 0; i < i16.size(); ++i) {
+        i16[i] = static_cast<std::int16_t>(i * 1000 - 18000);
+    }
+    for (std::size_t i = 0; i < f64.size(); ++i) {
+        f64[i] = i * 0.1 - 1;
+    }
+    std::vector<Vec3> points{{1, 2, 3}, {-4, 5.5f, 6}};
+
+    ForeignWriter writer;
+    writer.write(u32);
+    writer.write(i16);
+    writer.write(f64);
+    writer.write(std::uint64_t{points.size()});
+    for (const auto &p : points) {
+        writer.write(p.x);
+        writer.write(p.y);
+        writer.write(p.z);
+    }
+    writer.write(std::int64_t{-42});
+
+    std::vector<std::uint32_t> u32_out;
+    std::vector<std::int16_t> i16_out;
+    std::vector<double> f64_out;
+    std::vector<Vec3> points_out;
+    long l = 0;
+    InArchive iar{
+        BufferBinaryDeserializer{writer.bytes, BinaryOptions{.portable = true}}};
+    iar(make_nvp("u32", u32_out), make_nvp("i16", i16_out),
+        make_nvp("f64", f64_out), make_nvp("points", points_out),
+        make_nvp("l", l));
+    CHECK(u32_out == u32);
+    CHECK(i16_out == i16);
+    CHECK(f64_out == f64);
+    CHECK(points_out == points);
+    CHECK(l == -42);
+}
+
+TEST_CASE("byteswap", "[portable][simd]")
+{
+    for (std::size_t width : {2, 4, 8}) {
+        for (std::size_t count = 0; count < 70; ++count) {
+            std::vector<std::byte> expected(count * width);
+            for (std::size_t i = 0; i < expected.size(); ++i) {
+                expected[i] = static_cast<std::byte>(i * 7 + width);
+            }
+            auto swapped = expected;
+            std::vector<std::byte> copied(expected.size());
+            detail::ByteSwapCopy(copied.data(), expected.data(), count, width);
+            detail::ByteSwapInPlaceScalar(expected.data(), count, width);
+            detail::ByteSwapInPlace(swapped.data(), count, width);
+            CHECK(swapped == expected);
+            CHECK(copied == expected);
+        }
+    }
+    CHECK(detail::ByteSwap(std::uint32_t{0x01020304}) == 0x04030201);
+    CHECK(detail::ByteSwap(detail::ByteSwap(1.5)) == 1.5);
+}
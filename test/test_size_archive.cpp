@@ -0,0 +1,85 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+#include <zen_serialization/size_archive.h>
+
+using namespace zen;
+
+namespace
+{
+struct Node {
+    std::string name;
+    std::int64_t id{0};
+    long count{0};
+    std::vector<std::int32_t> values;
+    std::vector<std::array<float, 3>> points;
+    std::shared_ptr<Node> next;
+    std::weak_ptr<Node> self;
+    std::optional<std::wstring> label;
+    std::map<std::string, std::uint16_t> table;
+
+    SERIALIZE_MEMBER(name, id, count, values, points, next, self, label, table)
+};
+
+std::shared_ptr<Node> make_graph()
+{
+    auto root = std::make_shared<Node>();
+    root->name = "root";
+    root->id = -5;
+    root->count = 1 << 20;
+    root->label = L"label";
+    for (int i = 0; i < 300; ++i) {
+        root->values.push_back(i % 7 == 0 ? -70000 * i : i);
+        root->points.push_back({i * 1.f, i * 2.f, i * 3.f});
+        root->table.emplace(std::to_string(i), static_cast<std::uint16_t>(i));
+    }
+    root->next = std::make_shared<Node>();
+    root->next->name = "child";
+    // shared and cyclic references are only counted once
+    root->next->next = root;
+    root->self = root;
+    return root;
+}
+} // namespace
+
+TEST_CASE("size-archive", "[size]")
+{
+    auto graph = make_graph();
+    for (auto options : {BinaryOptions{}, BinaryOptions{.compact = true},
+                         BinaryOptions{.portable = true},
+                         BinaryOptions{.compact = true, .portable = true},
+                         BinaryOptions{.compact = true, .indexed = true}}) {
+        SizeArchive sizer{options};
+        sizer(make_nvp("graph", graph), make_nvp("again", graph));
+
+        std::vector<std::byte> buffer;
+        OutArchive oar{BufferBinarySerializer{buffer, options}};
+        oar(make_nvp("graph", graph), make_nvp("again", graph));
+        oar.Flush();
+
+        CHECK(sizer.Size() == buffer.size());
+    }
+}
+
+TEST_CASE("size-archive", "[size][preallocate]")
+{
+    auto graph = make_graph();
+    SizeArchive sizer;
+    sizer(make_nvp("graph", graph));
+
+    std::vector<std::byte> buffer;
+    OutArchive oar{BufferBinarySerializer{BufferSink{buffer, sizer.Size()}}};
+    auto data = buffer.data();
+    oar(make_nvp("graph", graph));
+    oar.Flush();
+
+    // the buffer was never reallocated
+    CHECK(buffer.data() == data);
+    CHECK(buffer.size() == sizer.Size());
+
+    std::shared_ptr<Node> graph_out;
+    InArchive iar{BufferBinaryDeserializer{buffer}};
+    iar(make_nvp("graph", graph_out));
+    REQUIRE(graph_out);
+    CHECK(graph_out->values == graph->values);
+    CHECK(graph_out->next->next == graph_out);
+}
@@ -1,5 +1,6 @@
 #include <catch.hpp>
 #include <zen_serialization/archive.h>
+#include <zen_serialization/size_archive.h>
 
 using namespace zen;
 
@@ -59,4 +60,85 @@ TEST_CASE("smart_pointers", "[smart_ptr]")
 {
     test_smart_pointers<JsonSerializer, JsonDeserializer>();
     test_smart_pointers<BinarySerializer, BinaryDeserializer>();
-}
\ No newline at end of file
+}
+TEST_CASE("smart_pointers", "[smart_ptr][deterministic]")
+{
+    auto save = [](std::size_t padding) {
+        // interleaved allocations put the nodes at different addresses
+        std::vector<std::unique_ptr<char[]>> noise;
+        std::vector<std::shared_ptr<Node>> nodes;
+        for (int i = 0; i < 50; ++i) {
+            noise.push_back(std::make_unique<char[]>(padding * (i + 1)));
+            auto node = std::make_shared<Node>();
+            node->value = i;
+            node->data = std::make_unique<int>(i);
+            if (!nodes.empty()) {
+                node->next = nodes.back();
+                node->loop = nodes.front();
+            }
+            nodes.push_back(node);
+        }
+        std::vector<std::byte> buffer;
+        OutArchive oar{
+            BufferBinarySerializer{buffer, BinaryOptions{.compact = true}}};
+        oar(make_nvp("nodes", nodes));
+        oar.Flush();
+        return buffer;
+    };
+    auto first = save(16);
+    auto second = save(4096);
+    CHECK(first == second);
+    // ids are assigned in traversal order and fit in a varint byte
+    CHECK(first.size() < 50 * 8);
+
+    InArchive iar{
+        BufferBinaryDeserializer{first, BinaryOptions{.compact = true}}};
+    std::vector<std::shared_ptr<Node>> nodes;
+    iar(make_nvp("nodes", nodes));
+    REQUIRE(nodes.size() == 50);
+    for (std::size_t i = 1; i < nodes.size(); ++i) {
+        CHECK(nodes[i]->value == static_cast<int>(i));
+        CHECK(*nodes[i]->data == static_cast<int>(i));
+        CHECK(nodes[i]->next == nodes[i - 1]);
+        CHECK(nodes[i]->loop.lock() == nodes[0]);
+    }
+}
+
+TEST_CASE("smart_pointers", "[smart_ptr][reserve]")
+{
+    std::vector<std::shared_ptr<Node>> nodes;
+    for (int i = 0; i < 1000; ++i) {
+        auto node = std::make_shared<Node>();
+        node->value = i;
+        node->data = std::make_unique<int>(-i);
+        if (!nodes.empty()) {
+            node->next = nodes[nodes.size() / 2];
+        }
+        nodes.push_back(node);
+    }
+    SizeArchive sizer;
+    sizer(make_nvp("nodes", nodes));
+    // every node and its data
+    REQUIRE(sizer.PointerCount() == 2000);
+
+    std::vector<std::byte> buffer;
+    {
+        OutArchive oar{BufferBinarySerializer{buffer}};
+        oar.ReservePointers(sizer.PointerCount());
+        oar(make_nvp("nodes", nodes));
+        oar.Flush();
+        CHECK(oar.PointerCount() == sizer.PointerCount());
+    }
+    CHECK(buffer.size() == sizer.Size());
+
+    InArchive iar{BufferBinaryDeserializer{buffer}};
+    iar.ReservePointers(sizer.PointerCount());
+    std::vector<std::shared_ptr<Node>> loaded;
+    iar(make_nvp("nodes", loaded));
+    REQUIRE(loaded.size() == nodes.size());
+    for (std::size_t i = 1; i < loaded.size(); ++i) {
+        CHECK(loaded[i]->value == static_cast<int>(i));
+        CHECK(*loaded[i]->data == -static_cast<int>(i));
+        CHECK(loaded[i]->next == loaded[i / 2]);
+    }
+}
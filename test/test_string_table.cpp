@@ -0,0 +1,162 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+#include <zen_serialization/size_archive.h>
+
+#include <sstream>
+
+using namespace zen;
+
+namespace
+{
+struct Figure {
+    virtual ~Figure() = default;
+    std::string layer;
+
+    SERIALIZE_MEMBER(layer)
+};
+
+struct Tile : Figure {
+    double side{0};
+
+    SERIALIZE_MEMBER(BaseClass<Figure>(this), side)
+};
+
+struct Drawing {
+    std::vector<std::shared_ptr<Figure>> figures;
+    std::vector<std::map<std::string, std::string>> rows;
+    std::vector<std::string> names;
+    Lazy<std::vector<std::string>> history;
+    std::string footer;
+
+    SERIALIZE_MEMBER(figures, rows, names, history, footer)
+};
+
+Drawing make_drawing()
+{
+    Drawing drawing;
+    for (int i = 0; i < 200; ++i) {
+        auto tile = std::make_shared<Tile>();
+        tile->layer = i % 2 ? "background layer" : "foreground layer";
+        tile->side = i;
+        drawing.figures.push_back(tile);
+        drawing.rows.push_back({{"status", i % 3 ? "active" : "archived"},
+                                {"owner", "somebody@example.com"},
+                                {"note", ""}});
+        drawing.names.push_back(fmt::format("name{}", i % 10));
+    }
+    // shares strings with the rest of the archive, written before and after
+    drawing.history = std::vector<std::string>{
+        "active", "created by somebody@example.com", "active", "renamed"};
+    drawing.footer = "renamed";
+    return drawing;
+}
+
+void check_drawing(Drawing &loaded, const Drawing &drawing)
+{
+    REQUIRE(loaded.figures.size() == drawing.figures.size());
+    for (std::size_t i = 0; i < drawing.figures.size(); ++i) {
+        auto tile = std::dynamic_pointer_cast<Tile>(loaded.figures[i]);
+        REQUIRE(tile);
+        CHECK(tile->layer == drawing.figures[i]->layer);
+        CHECK(tile->side == static_cast<double>(i));
+    }
+    CHECK(loaded.rows == drawing.rows);
+    CHECK(loaded.names == drawing.names);
+    CHECK(loaded.footer == drawing.footer);
+    CHECK(loaded.history.get() == drawing.history.get());
+}
+} // namespace
+
+REGISTER_CLASS(Figure)
+REGISTER_CLASS(Tile)
+
+TEST_CASE("string-table", "[string_table][buffer]")
+{
+    auto drawing = make_drawing();
+    std::vector<std::byte> plain;
+    {
+        OutArchive oar{BufferBinarySerializer{plain}};
+        oar(make_nvp("drawing", drawing));
+        oar.Flush();
+    }
+    for (auto options : {BinaryOptions{.string_table = true},
+                         BinaryOptions{.compact = true, .string_table = true},
+                         BinaryOptions{.portable = true,
+                                       .string_table = true}}) {
+        std::vector<std::byte> buffer;
+        {
+            OutArchive oar{BufferBinarySerializer{buffer, options}};
+            oar(make_nvp("drawing", drawing));
+            oar.Flush();
+        }
+        CHECK(buffer.size() * 2 < plain.size());
+
+        SizeArchive sizer{options};
+        sizer(make_nvp("drawing", drawing));
+        CHECK(sizer.Size() == buffer.size());
+
+        InArchive iar{BufferBinaryDeserializer{buffer, options}};
+        Drawing loaded;
+        iar(make_nvp("drawing", loaded));
+        check_drawing(loaded, drawing);
+    }
+}
+
+TEST_CASE("string-table", "[string_table][stream]")
+{
+    auto drawing = make_drawing();
+    BinaryOptions options{.string_table = true};
+    std::stringstream ss;
+    {
+        OutArchive oar{BinarySerializer{ss, options}};
+        oar(make_nvp("drawing", drawing), make_nvp("again", drawing.names));
+    }
+    InArchive iar{BinaryDeserializer{ss, options}};
+    Drawing loaded;
+    std::vector<std::string> again;
+    iar(make_nvp("drawing", loaded), make_nvp("again", again));
+    // the Lazy member is decoded after "again" was read
+    check_drawing(loaded, drawing);
+    CHECK(again == drawing.names);
+}
+
+TEST_CASE("string-table", "[string_table][borrowed]")
+{
+    std::vector<std::string> words{"alpha", "beta", "alpha", "", "beta"};
+    BinaryOptions options{.string_table = true};
+    std::vector<std::byte> buffer;
+    {
+        OutArchive oar{BufferBinarySerializer{buffer, options}};
+        oar(make_nvp("words", words));
+        oar.Flush();
+    }
+    InArchive iar{BufferBinaryDeserializer{buffer, options}};
+    std::vector<std::string_view> views;
+    iar(make_nvp("words", views));
+    REQUIRE(views.size() == words.size());
+    CHECK(views == std::vector<std::string_view>(words.begin(), words.end()));
+    // repeated strings point to their first occurrence in the buffer
+    CHECK(views[0].data() == views[2].data());
+    CHECK(views[1].data() == views[4].data());
+}
+
+TEST_CASE("string-table", "[string_table][errors]")
+{
+    std::vector<std::byte> buffer;
+    CHECK_THROWS(BufferBinarySerializer{
+        buffer, BinaryOptions{.indexed = true, .string_table = true}});
+    CHECK_THROWS(BufferBinarySerializer{
+        buffer, BinaryOptions{.tagged = true, .string_table = true}});
+
+    BinaryOptions options{.string_table = true};
+    {
+        OutArchive oar{BufferBinarySerializer{buffer, options}};
+        oar(make_nvp("value", std::string("value")));
+        oar.Flush();
+    }
+    // after the 6 byte header: refer to string 3 of an empty table
+    buffer[6] = std::byte{2 * 3 + 1};
+    InArchive iar{BufferBinaryDeserializer{buffer, options}};
+    std::string value;
+    CHECK_THROWS(iar(make_nvp("value", value)));
+}
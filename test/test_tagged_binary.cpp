@@ -0,0 +1,241 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+#include <zen_serialization/size_archive.h>
+
+#include <sstream>
+
+using namespace zen;
+
+namespace
+{
+struct Point {
+    double x{0};
+    double y{0};
+
+    bool operator==(const Point &) const = default;
+
+    SERIALIZE_MEMBER(x, y)
+};
+
+// version 1 of a record
+struct RecordV1 {
+    std::string name;
+    std::int32_t count{0};
+    std::vector<Point> points;
+    std::string comment;
+
+    SERIALIZE_MEMBER(name, count, points, comment)
+};
+
+// version 2: count was removed, fields were reordered and added
+struct RecordV2 {
+    std::vector<Point> points;
+    std::map<std::string, std::int32_t> tags{{"default", 1}};
+    std::string name;
+    std::string comment;
+    double scale{1.5};
+
+    SERIALIZE_MEMBER(points, tags, name, comment, scale)
+};
+
+// comment has a different type than it was written with
+struct RecordWrong {
+    std::vector<std::string> comment;
+
+    SERIALIZE_MEMBER(comment)
+};
+
+RecordV1 make_record()
+{
+    return RecordV1{"record", 3, {{1, 2}, {3, 4}, {5, 6}}, "first version"};
+}
+
+void check_v2(const RecordV2 &loaded, const RecordV1 &record)
+{
+    CHECK(loaded.name == record.name);
+    CHECK(loaded.points == record.points);
+    CHECK(loaded.comment == record.comment);
+    // missing from the archive: untouched
+    CHECK(loaded.tags == std::map<std::string, std::int32_t>{{"default", 1}});
+    CHECK(loaded.scale == 1.5);
+}
+
+struct Shape {
+    virtual ~Shape() = default;
+    std::string label;
+
+    SERIALIZE_MEMBER(label)
+};
+
+struct Circle : Shape {
+    double radius{0};
+
+    SERIALIZE_MEMBER(BaseClass<Shape>(this), radius)
+};
+
+struct Node {
+    std::string name;
+    std::shared_ptr<Node> next;
+
+    SERIALIZE_MEMBER(name, next)
+};
+
+struct Document {
+    std::shared_ptr<Shape> shape;
+    std::shared_ptr<Node> first;
+    std::shared_ptr<Node> second;
+    Lazy<std::vector<Point>> outline;
+    std::optional<std::string> title;
+    std::tuple<std::int32_t, std::string> version{2, "beta"};
+
+    SERIALIZE_MEMBER(shape, first, second, outline, title, version)
+};
+} // namespace
+
+REGISTER_CLASS(Shape)
+REGISTER_CLASS(Circle)
+
+TEST_CASE("tagged-binary", "[tagged][evolution]")
+{
+    auto record = make_record();
+    for (auto options : {BinaryOptions{.tagged = true},
+                         BinaryOptions{.compact = true, .tagged = true},
+                         BinaryOptions{.portable = true, .tagged = true}}) {
+        std::vector<std::byte> buffer;
+        {
+            OutArchive oar{BufferBinarySerializer{buffer, options}};
+            oar(make_nvp("record", record), make_nvp("tail", 42));
+            oar.Flush();
+        }
+
+        InArchive iar{BufferBinaryDeserializer{buffer, options}};
+        RecordV1 same;
+        std::int32_t tail = 0;
+        iar(make_nvp("record", same), make_nvp("tail", tail));
+        CHECK(same.name == record.name);
+        CHECK(same.count == record.count);
+        CHECK(same.points == record.points);
+        CHECK(tail == 42);
+
+        InArchive iar2{BufferBinaryDeserializer{buffer, options}};
+        RecordV2 loaded;
+        std::int32_t missing = 7;
+        tail = 0;
+        // top-level fields are matched by name as well
+        iar2(make_nvp("missing", missing), make_nvp("tail", tail),
+             make_nvp("record", loaded));
+        check_v2(loaded, record);
+        CHECK(missing == 7);
+        CHECK(tail == 42);
+    }
+}
+
+TEST_CASE("tagged-binary", "[tagged][stream]")
+{
+    auto record = make_record();
+    BinaryOptions options{.compact = true, .tagged = true};
+    std::stringstream ss;
+    {
+        OutArchive oar{BinarySerializer{ss, options}};
+        oar(make_nvp("record", record));
+    }
+    InArchive iar{BinaryDeserializer{ss, options}};
+    RecordV2 loaded;
+    iar(make_nvp("record", loaded));
+    check_v2(loaded, record);
+}
+
+TEST_CASE("tagged-binary", "[tagged][pointers]")
+{
+    Document document;
+    auto circle = std::make_shared<Circle>();
+    circle->label = "circle";
+    circle->radius = 2.5;
+    document.shape = circle;
+    document.first = std::make_shared<Node>(Node{"first", nullptr});
+    document.second = std::make_shared<Node>(Node{"second", document.first});
+    document.outline = std::vector<Point>{{0, 0}, {1, 1}};
+    document.title = "drawing";
+
+    for (auto options : {BinaryOptions{.tagged = true},
+                         BinaryOptions{.compact = true, .tagged = true}}) {
+        std::vector<std::byte> buffer;
+        {
+            OutArchive oar{BufferBinarySerializer{buffer, options}};
+            oar(make_nvp("document", document));
+            oar.Flush();
+        }
+        SizeArchive sizer{options};
+        sizer(make_nvp("document", document));
+        CHECK(sizer.Size() == buffer.size());
+
+        InArchive iar{BufferBinaryDeserializer{buffer, options}};
+        Document loaded;
+        iar(make_nvp("document", loaded));
+        auto shape = std::dynamic_pointer_cast<Circle>(loaded.shape);
+        REQUIRE(shape);
+        CHECK(shape->label == "circle");
+        CHECK(shape->radius == 2.5);
+        REQUIRE(loaded.second);
+        CHECK(loaded.second->next == loaded.first);
+        CHECK(loaded.first->name == "first");
+        CHECK_FALSE(loaded.outline.IsLoaded());
+        CHECK(loaded.outline.get() == document.outline.get());
+        CHECK(loaded.title == document.title);
+        CHECK(loaded.version == document.version);
+    }
+}
+
+TEST_CASE("tagged-binary", "[tagged][index]")
+{
+    std::vector<Point> points;
+    for (int i = 0; i < 10000; ++i) {
+        points.push_back({i * 1.0, i * 2.0});
+    }
+    auto record = make_record();
+    BinaryOptions options{.indexed = true, .tagged = true};
+    std::vector<std::byte> buffer;
+    {
+        OutArchive oar{BufferBinarySerializer{buffer, options}};
+        oar(make_nvp("record", record), make_nvp("points", points),
+            make_nvp("tail", 42));
+        oar.Flush();
+    }
+    InArchive iar{BufferBinaryDeserializer{buffer, options}};
+    std::int32_t tail = 0;
+    iar.Seek("tail")(make_nvp("tail", tail));
+    CHECK(tail == 42);
+    RecordV2 loaded;
+    iar.Seek("record")(make_nvp("record", loaded));
+    check_v2(loaded, record);
+    std::vector<Point> range;
+    iar.LoadRange("points", 9995, 10, range);
+    REQUIRE(range.size() == 5);
+    CHECK(range.front() == points[9995]);
+}
+
+TEST_CASE("tagged-binary", "[tagged][errors]")
+{
+    auto record = make_record();
+    BinaryOptions options{.tagged = true};
+    std::stringstream ss;
+    {
+        OutArchive oar{ChecksummedBinarySerializer{
+            ChecksumSink<StreamSink>{ss, {}}, options}};
+        oar(make_nvp("record", record));
+        oar.Flush();
+    }
+    // fields are located by seeking
+    CHECK_THROWS(ChecksummedBinaryDeserializer{
+        ChecksumSource<StreamSource>{ss, {}}, options});
+
+    std::vector<std::byte> buffer;
+    {
+        OutArchive oar{BufferBinarySerializer{buffer, options}};
+        oar(make_nvp("record", record));
+        oar.Flush();
+    }
+    InArchive iar{BufferBinaryDeserializer{buffer, options}};
+    RecordWrong wrong;
+    CHECK_THROWS(iar(make_nvp("record", wrong)));
+}
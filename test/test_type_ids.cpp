@@ -0,0 +1,176 @@
+#include <catch.hpp>
+#include <zen_serialization/archive.h>
+#include <zen_serialization/size_archive.h>
+
+#include <sstream>
+
+using namespace zen;
+
+namespace
+{
+struct Pet {
+    virtual ~Pet() = default;
+    std::string name;
+
+    SERIALIZE_MEMBER(name)
+};
+
+struct Puppy : Pet {
+    std::int32_t tricks{0};
+
+    SERIALIZE_MEMBER(BaseClass<Pet>(this), tricks)
+};
+
+struct Kitten : Pet {
+    std::vector<std::shared_ptr<Pet>> friends;
+
+    SERIALIZE_MEMBER(BaseClass<Pet>(this), friends)
+};
+
+struct Zoo {
+    std::vector<std::shared_ptr<Pet>> animals;
+    Lazy<std::vector<std::shared_ptr<Pet>>> visitors;
+    std::int32_t tail{0};
+
+    SERIALIZE_MEMBER(animals, visitors, tail)
+};
+
+Zoo make_zoo()
+{
+    Zoo zoo;
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3) {
+            auto puppy = std::make_shared<Puppy>();
+            puppy->name = fmt::format("puppy{}", i);
+            puppy->tricks = i;
+            zoo.animals.push_back(puppy);
+        } else {
+            auto cat = std::make_shared<Kitten>();
+            cat->name = fmt::format("cat{}", i);
+            // nested pointers add types while the outer one is being read
+            auto kitten = std::make_shared<Kitten>();
+            kitten->name = "kitten";
+            cat->friends.push_back(kitten);
+            if (!zoo.animals.empty()) {
+                cat->friends.push_back(zoo.animals.back());
+            }
+            zoo.animals.push_back(cat);
+        }
+    }
+    auto visitor = std::make_shared<Puppy>();
+    visitor->name = "visitor";
+    zoo.visitors = std::vector<std::shared_ptr<Pet>>{visitor};
+    zoo.tail = 42;
+    return zoo;
+}
+
+void check_zoo(Zoo &loaded, const Zoo &zoo)
+{
+    REQUIRE(loaded.animals.size() == zoo.animals.size());
+    for (std::size_t i = 0; i < zoo.animals.size(); ++i) {
+        CHECK(loaded.animals[i]->name == zoo.animals[i]->name);
+        if (auto puppy = std::dynamic_pointer_cast<Puppy>(zoo.animals[i])) {
+            auto loaded_puppy =
+                std::dynamic_pointer_cast<Puppy>(loaded.animals[i]);
+            REQUIRE(loaded_puppy);
+            CHECK(loaded_puppy->tricks == puppy->tricks);
+        } else {
+            auto cat = std::dynamic_pointer_cast<Kitten>(loaded.animals[i]);
+            REQUIRE(cat);
+            REQUIRE(!cat->friends.empty());
+            CHECK(std::dynamic_pointer_cast<Kitten>(cat->friends[0]));
+            if (i > 0) {
+                REQUIRE(cat->friends.size() == 2);
+                CHECK(cat->friends[1] == loaded.animals[i - 1]);
+            }
+        }
+    }
+    CHECK(loaded.tail == zoo.tail);
+    REQUIRE(loaded.visitors.get().size() == 1);
+    CHECK(std::dynamic_pointer_cast<Puppy>(loaded.visitors.get()[0]));
+    CHECK(loaded.visitors.get()[0]->name == "visitor");
+}
+} // namespace
+
+REGISTER_CLASS(Pet)
+REGISTER_CLASS(Puppy)
+REGISTER_CLASS(Kitten)
+
+TEST_CASE("type-ids", "[type_ids][buffer]")
+{
+    auto zoo = make_zoo();
+    std::vector<std::byte> plain;
+    {
+        OutArchive oar{BufferBinarySerializer{plain}};
+        oar(make_nvp("zoo", zoo));
+        oar.Flush();
+    }
+    for (auto options :
+         {BinaryOptions{.type_ids = true},
+          BinaryOptions{.compact = true, .type_ids = true},
+          BinaryOptions{.portable = true, .type_ids = true},
+          BinaryOptions{.string_table = true, .type_ids = true}}) {
+        std::vector<std::byte> buffer;
+        {
+            OutArchive oar{BufferBinarySerializer{buffer, options}};
+            oar(make_nvp("zoo", zoo));
+            oar.Flush();
+        }
+        CHECK(buffer.size() < plain.size());
+
+        SizeArchive sizer{options};
+        sizer(make_nvp("zoo", zoo));
+        CHECK(sizer.Size() == buffer.size());
+
+        InArchive iar{BufferBinaryDeserializer{buffer, options}};
+        Zoo loaded;
+        iar(make_nvp("zoo", loaded));
+        check_zoo(loaded, zoo);
+    }
+}
+
+TEST_CASE("type-ids", "[type_ids][stream]")
+{
+    auto zoo = make_zoo();
+    BinaryOptions options{.type_ids = true};
+    std::stringstream ss;
+    {
+        OutArchive oar{BinarySerializer{ss, options}};
+        oar(make_nvp("zoo", zoo), make_nvp("again", zoo.animals));
+    }
+    InArchive iar{BinaryDeserializer{ss, options}};
+    Zoo loaded;
+    std::vector<std::shared_ptr<Pet>> again;
+    iar(make_nvp("zoo", loaded), make_nvp("again", again));
+    // the Lazy payload has its own dictionary, decoded after "again"
+    check_zoo(loaded, zoo);
+    REQUIRE(again.size() == zoo.animals.size());
+    CHECK(again[1] == loaded.animals[1]);
+}
+
+TEST_CASE("type-ids", "[type_ids][errors]")
+{
+    std::vector<std::byte> buffer;
+    CHECK_THROWS(BufferBinarySerializer{
+        buffer, BinaryOptions{.indexed = true, .type_ids = true}});
+    CHECK_THROWS(BufferBinarySerializer{
+        buffer, BinaryOptions{.tagged = true, .type_ids = true}});
+
+    BinaryOptions options{.type_ids = true};
+    std::shared_ptr<Pet> puppy = std::make_shared<Puppy>();
+    {
+        OutArchive oar{BufferBinarySerializer{buffer, options}};
+        oar(make_nvp("puppy", puppy));
+        oar.Flush();
+    }
+    // the new type's id precedes its length prefixed name
+    std::string_view bytes(reinterpret_cast<const char *>(buffer.data()),
+                           buffer.size());
+    auto name = bytes.find("Puppy");
+    REQUIRE(name != std::string_view::npos);
+    std::vector<std::byte> bad(buffer);
+    bad[name - sizeof(std::uint64_t) - sizeof(std::uint32_t)] = std::byte{3};
+    InArchive iar{BufferBinaryDeserializer{bad, options}};
+    std::shared_ptr<Pet> loaded;
+    CHECK_THROWS(iar(make_nvp("puppy", loaded)));
+}